@@ -2,17 +2,118 @@
 // SRMS - Student Record Management System
 // Login + SRM-themed professional colourful GUI (Win32 API) + in-memory backend
 
+#ifndef SRMS_NO_GUI          // -DSRMS_NO_GUI: console-only build (follower / headless leader)
+#define NOMINMAX             // keep <windows.h> from defining min/max macros over std::min/std::max
 #include <windows.h>
+#endif
 #include <string>
 #include <vector>
-#include <sstream>
 #include <cstdlib>
-#include <iomanip>
+#include <tuple>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <functional>
+#include <cctype>
+#include <unordered_map>
+#include <cmath>
+#include <cstdio>
+#include <chrono>
+#include <ctime>
+#include <type_traits>
+#include <limits>
+#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <cerrno>
+#ifndef _WIN32
+#include <poll.h>            // console mode: wait on stdin with a timeout
+#include <unistd.h>
+#endif
 
 using std::string;
 using std::vector;
-using std::ostringstream;
-using std::setw;
+
+// ======================== TABLE FORMATTER ========================
+// Writes fixed-width, left-aligned columns straight into one buffer that the
+// caller sizes up front (see schema_rowBound), so a whole listing costs a
+// single allocation. Numbers go through to_chars: no locale, no streams.
+// Float output matches the old ostream default (%g, 6 significant digits).
+
+// worst-case characters one value can take in a cell
+constexpr size_t INT_CHARS   = 11;   // "-2147483648"
+constexpr size_t LONG_CHARS  = 20;   // "-9223372036854775808"
+constexpr size_t FLOAT_CHARS = 16;   // "-1.17549e-38" + slack
+
+class TableWriter {
+public:
+    explicit TableWriter(size_t capacity) : buf_(capacity, '\0'), pos_(0) {}
+
+    void text(const char* s, size_t n) {
+        reserve(n);
+        std::memcpy(&buf_[pos_], s, n);
+        pos_ += n;
+    }
+    void text(const char* s)     { text(s, std::strlen(s)); }
+    void text(const string& s)   { text(s.data(), s.size()); }
+    void newline()               { text("\r\n", 2); }
+
+    void cell(const char* s, size_t n, int width) {
+        text(s, n);
+        if ((size_t)width > n) pad((size_t)width - n);
+    }
+    void cell(const char* s, int width)   { cell(s, std::strlen(s), width); }
+    void cell(const string& s, int width) { cell(s.data(), s.size(), width); }
+    void cell(char c, int width)          { cell(&c, 1, width); }
+
+    void cell(int v, int width) {
+        char tmp[INT_CHARS + 1];
+        auto res = std::to_chars(tmp, tmp + sizeof tmp, v);
+        cell(tmp, (size_t)(res.ptr - tmp), width);
+    }
+    void cell(long long v, int width) {
+        char tmp[LONG_CHARS + 1];
+        auto res = std::to_chars(tmp, tmp + sizeof tmp, v);
+        cell(tmp, (size_t)(res.ptr - tmp), width);
+    }
+    void cell(float v, int width) {
+        char tmp[FLOAT_CHARS + 8];
+        auto res = std::to_chars(tmp, tmp + sizeof tmp, v, std::chars_format::general, 6);
+        cell(tmp, (size_t)(res.ptr - tmp), width);
+    }
+
+    // hands the buffer over; trims to what was written (no reallocation)
+    string take() {
+        buf_.resize(pos_);
+        return std::move(buf_);
+    }
+
+private:
+    void pad(size_t n) {
+        reserve(n);
+        std::memset(&buf_[pos_], ' ', n);
+        pos_ += n;
+    }
+    // only hit when the caller's estimate was too small
+    void reserve(size_t n) {
+        if (pos_ + n > buf_.size())
+            buf_.resize(std::max(buf_.size() * 2, pos_ + n));
+    }
+
+    string buf_;
+    size_t pos_;
+};
+
+inline size_t value_bound(int)             { return INT_CHARS; }
+inline size_t value_bound(long long)       { return LONG_CHARS; }
+inline size_t value_bound(float)           { return FLOAT_CHARS; }
+inline size_t value_bound(char)            { return 1; }
+inline size_t value_bound(const string& s) { return s.size(); }
+inline size_t value_bound(const char* s)   { return std::strlen(s); }
 
 // ======================== BACKEND (IN-MEMORY) ========================
 
@@ -23,6 +124,7 @@ struct Student {
     int sem;
     float cgpa;
     char grade;
+    long long updatedAt;     // last write to the record (unix seconds)
 };
 
 struct Query {
@@ -30,192 +132,3182 @@ struct Query {
     int roll;
     string name;
     string message;
-    string status;   // e.g. "Pending"
+    string status;   // "Pending", "Escalated" or "Resolved"
+    long long submittedAt;   // unix seconds
+    long long updatedAt;     // last status change
+};
+
+inline uint64_t now_ms() {
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+inline long long now_s() { return (long long)(now_ms() / 1000); }
+
+// ======================== RECORD SCHEMA (COMPILE-TIME) ========================
+// Every record type lists its fields exactly once, in Schema<T>. The table /
+// detail formatters, text parser, binary encoder and comparisons below are
+// generated from that list by folding over the tuple, so each call expands
+// to straight-line code per field (no runtime dispatch).
+// Adding a field = add the member to the struct + one line in its Schema
+// (plus an admin form box if it is an input column, see field_isInput).
+// Code that creates records starts from a value-initialized struct and names
+// the fields it sets, so it needs no change either.
+
+enum FieldFlags : unsigned {
+    FIELD_KEY    = 1u << 0,  // identifies the record, never overwritten on update
+    FIELD_SPACED = 1u << 1,  // table column always followed by one space
+    FIELD_HIDDEN = 1u << 2,  // stored/encoded/filterable, kept out of tables and input
+                             // columns (the detail view still shows it)
+    FIELD_TIME   = 1u << 3,  // unix seconds, shown as local date and time
+    FIELD_READONLY = 1u << 4 // shown in tables like any column, never an input column
+};
+
+// typed in by the user (admin form box, console argument)
+constexpr bool field_isInput(unsigned flags) {
+    return !(flags & (FIELD_HIDDEN | FIELD_READONLY));
+}
+
+template <typename Rec, typename T>
+struct Field {
+    const char* label;     // detail view ("Roll   : 7")
+    const char* header;    // table column header ("ROLL")
+    T Rec::*    member;
+    int         width;     // table column width (0 = last column, unpadded)
+    unsigned    flags;
+};
+
+template <typename Rec, typename T>
+constexpr Field<Rec, T> field(const char* label, const char* header,
+                              T Rec::* member, int width, unsigned flags = 0) {
+    return Field<Rec, T>{label, header, member, width, flags};
+}
+
+template <typename Rec> struct Schema;
+
+template <> struct Schema<Student> {
+    static constexpr auto fields = std::make_tuple(
+        field("Roll",  "ROLL",  &Student::roll,  5, FIELD_KEY | FIELD_SPACED),
+        field("Name",  "NAME",  &Student::name,  18),
+        field("Dept",  "DEPT",  &Student::dept,  10),
+        field("Sem",   "SEM",   &Student::sem,   6),
+        field("CGPA",  "CGPA",  &Student::cgpa,  7),
+        field("Grade", "GRADE", &Student::grade, 7),
+        field("Updated", "UPDATED", &Student::updatedAt, 0, FIELD_HIDDEN | FIELD_TIME)
+    );
+};
+
+template <> struct Schema<Query> {
+    static constexpr auto fields = std::make_tuple(
+        field("ID",      "ID",      &Query::id,      3, FIELD_KEY | FIELD_SPACED),
+        field("Roll",    "ROLL",    &Query::roll,    5, FIELD_SPACED),
+        field("Name",    "NAME",    &Query::name,    15),
+        field("Status",  "STATUS",  &Query::status,  10),
+        field("Submitted", "SUBMITTED", &Query::submittedAt, 17, FIELD_READONLY | FIELD_TIME),
+        field("Message", "MESSAGE", &Query::message, 0),
+        field("Updated",   "UPDATED",   &Query::updatedAt,   0, FIELD_HIDDEN | FIELD_TIME)
+    );
+};
+
+template <typename Rec, typename Fn>
+constexpr void schema_forEach(Fn&& fn) {
+    std::apply([&](const auto&... f) { (fn(f), ...); }, Schema<Rec>::fields);
+}
+
+// number of input columns (fields typed in by the user, in schema order)
+template <typename Rec>
+constexpr size_t schema_inputCount() {
+    size_t n = 0;
+    schema_forEach<Rec>([&](const auto& f) { if (field_isInput(f.flags)) ++n; });
+    return n;
+}
+
+// ---- per-type value helpers (overloads picked at compile time) ----
+
+inline void value_parse(const string& s, int& v)    { v = std::atoi(s.c_str()); }
+inline void value_parse(const string& s, long long& v) { v = std::atoll(s.c_str()); }
+inline void value_parse(const string& s, float& v)  { v = (float)std::atof(s.c_str()); }
+inline void value_parse(const string& s, char& v)   { v = s.empty() ? '-' : s[0]; }
+inline void value_parse(const string& s, string& v) { v = s; }
+
+inline void put_u32(string& out, uint32_t u) {
+    for (int i = 0; i < 4; ++i) out.push_back((char)(u >> (8 * i)));
+}
+
+inline bool get_u32(const char*& p, const char* end, uint32_t& u) {
+    if (end - p < 4) return false;
+    u = 0;
+    for (int i = 0; i < 4; ++i) u |= (uint32_t)(unsigned char)p[i] << (8 * i);
+    p += 4;
+    return true;
+}
+
+inline void put_u64(string& out, uint64_t u) {
+    put_u32(out, (uint32_t)u);
+    put_u32(out, (uint32_t)(u >> 32));
+}
+
+inline bool get_u64(const char*& p, const char* end, uint64_t& u) {
+    uint32_t lo, hi;
+    if (!get_u32(p, end, lo) || !get_u32(p, end, hi)) return false;
+    u = ((uint64_t)hi << 32) | lo;
+    return true;
+}
+
+inline void put_varint(string& out, uint64_t u) {
+    while (u >= 0x80) { out.push_back((char)(u | 0x80)); u >>= 7; }
+    out.push_back((char)u);
+}
+
+inline bool get_varint(const char*& p, const char* end, uint64_t& u) {
+    u = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        unsigned char b = (unsigned char)*p++;
+        u |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+inline void value_encode(string& out, int v)    { put_u32(out, (uint32_t)v); }
+inline void value_encode(string& out, long long v) { put_u64(out, (uint64_t)v); }
+inline void value_encode(string& out, float v)  { uint32_t u; std::memcpy(&u, &v, 4); put_u32(out, u); }
+inline void value_encode(string& out, char v)   { out.push_back(v); }
+inline void value_encode(string& out, const string& v) {
+    put_varint(out, v.size());
+    out.append(v);
+}
+
+inline bool value_decode(const char*& p, const char* end, int& v) {
+    uint32_t u;
+    if (!get_u32(p, end, u)) return false;
+    v = (int)u;
+    return true;
+}
+inline bool value_decode(const char*& p, const char* end, long long& v) {
+    uint64_t u;
+    if (!get_u64(p, end, u)) return false;
+    v = (long long)u;
+    return true;
+}
+inline bool value_decode(const char*& p, const char* end, float& v) {
+    uint32_t u;
+    if (!get_u32(p, end, u)) return false;
+    std::memcpy(&v, &u, 4);
+    return true;
+}
+inline bool value_decode(const char*& p, const char* end, char& v) {
+    if (p >= end) return false;
+    v = *p++;
+    return true;
+}
+inline bool value_decode(const char*& p, const char* end, string& v) {
+    uint64_t n;
+    if (!get_varint(p, end, n) || (uint64_t)(end - p) < n) return false;
+    v.assign(p, (size_t)n);
+    p += n;
+    return true;
+}
+
+// local time of a FIELD_TIME value; 0 if it cannot be formatted
+inline size_t format_time(char* buf, size_t size, long long v, const char* fmt) {
+    std::time_t t = (std::time_t)v;
+    const std::tm* tm = std::localtime(&t);
+    return tm ? std::strftime(buf, size, fmt, tm) : 0;
+}
+
+// table cell of a field (times to the minute, "2026-10-18 18:54")
+template <typename T>
+void table_value(TableWriter& tw, const T& v, int width, unsigned) { tw.cell(v, width); }
+
+inline void table_value(TableWriter& tw, long long v, int width, unsigned flags) {
+    char buf[32];
+    size_t n = (flags & FIELD_TIME) ? format_time(buf, sizeof buf, v, "%Y-%m-%d %H:%M") : 0;
+    if (n) tw.cell(buf, n, width);
+    else   tw.cell(v, width);
+}
+
+// ---- record-level operations generated from Schema<Rec> ----
+
+template <typename Rec>
+void schema_header(TableWriter& tw) {
+    schema_forEach<Rec>([&](const auto& f) {
+        if (f.flags & FIELD_HIDDEN) return;
+        tw.cell(f.header, f.width);
+        if (f.flags & FIELD_SPACED) tw.text(" ", 1);
+    });
+}
+
+template <typename Rec>
+void schema_row(TableWriter& tw, const Rec& r) {
+    schema_forEach<Rec>([&](const auto& f) {
+        if (f.flags & FIELD_HIDDEN) return;
+        table_value(tw, r.*f.member, f.width, f.flags);
+        if (f.flags & FIELD_SPACED) tw.text(" ", 1);
+    });
+}
+
+template <typename T>
+void detail_value(TableWriter& tw, const T& v, unsigned) { tw.cell(v, 0); }
+
+inline void detail_value(TableWriter& tw, long long v, unsigned flags) {
+    char buf[32];
+    size_t n = (flags & FIELD_TIME) ? format_time(buf, sizeof buf, v, "%Y-%m-%d %H:%M:%S") : 0;
+    if (n) tw.cell(buf, n, 0);
+    else   tw.cell(v, 0);
+}
+
+// labels are padded to the longest one (at least 7, "Message")
+template <typename Rec>
+size_t schema_labelWidth() {
+    size_t w = 7;
+    schema_forEach<Rec>([&](const auto& f) { w = std::max(w, std::strlen(f.label)); });
+    return w;
+}
+
+// "Label  : value" lines, separated by \r\n (no trailing newline)
+template <typename Rec>
+void schema_detail(TableWriter& tw, const Rec& r) {
+    const int labelWidth = (int)schema_labelWidth<Rec>();
+    bool first = true;
+    schema_forEach<Rec>([&](const auto& f) {
+        if (!first) tw.newline();
+        first = false;
+        tw.cell(f.label, labelWidth);
+        tw.text(": ", 2);
+        detail_value(tw, r.*f.member, f.flags);
+    });
+}
+
+// upper bounds on the characters the three writers above can produce
+template <typename Rec>
+size_t schema_headerBound() {
+    size_t n = 0;
+    schema_forEach<Rec>([&](const auto& f) {
+        if (f.flags & FIELD_HIDDEN) return;
+        n += std::max((size_t)f.width, std::strlen(f.header)) + 1;
+    });
+    return n;
+}
+
+template <typename Rec>
+size_t schema_rowBound(const Rec& r) {
+    size_t n = 0;
+    schema_forEach<Rec>([&](const auto& f) {
+        if (f.flags & FIELD_HIDDEN) return;
+        n += std::max((size_t)f.width, value_bound(r.*f.member)) + 1;
+    });
+    return n;
+}
+
+template <typename Rec>
+size_t schema_detailBound(const Rec& r) {
+    size_t n = 0;
+    const size_t labelWidth = schema_labelWidth<Rec>();
+    schema_forEach<Rec>([&](const auto& f) {
+        n += labelWidth + 2 + value_bound(r.*f.member) + 2;   // dates fit in LONG_CHARS
+    });
+    return n;
+}
+
+// One column of Rec, looked up by member, for views that put fields of
+// several record types side by side (same header, width and spacing as in
+// the record's own table).
+struct SchemaColumn {
+    const char* header;
+    int         width;
+    unsigned    flags;
+};
+
+template <typename Rec, typename T>
+SchemaColumn schema_column(T Rec::* member) {
+    SchemaColumn c{"", 0, 0};
+    schema_forEach<Rec>([&](const auto& f) {
+        if constexpr (std::is_same<decltype(f.member), T Rec::*>::value) {
+            if (f.member == member) c = SchemaColumn{f.header, f.width, f.flags};
+        }
+    });
+    return c;
+}
+
+inline void column_header(TableWriter& tw, const SchemaColumn& c) {
+    tw.cell(c.header, c.width);
+    if (c.flags & FIELD_SPACED) tw.text(" ", 1);
+}
+
+template <typename T>
+void column_cell(TableWriter& tw, const SchemaColumn& c, const T& v) {
+    table_value(tw, v, c.width, c.flags);
+    if (c.flags & FIELD_SPACED) tw.text(" ", 1);
+}
+
+template <typename T>
+size_t column_bound(const SchemaColumn& c, const T& v) {
+    return std::max((size_t)c.width, value_bound(v)) + 1;
+}
+
+// cols are raw text values of the input columns, in schema order (e.g. from
+// the edit boxes); other fields and empty columns are left as they are
+template <typename Rec>
+bool schema_parse(const vector<string>& cols, Rec& r) {
+    if (cols.size() != schema_inputCount<Rec>())
+        return false;
+    size_t i = 0;
+    schema_forEach<Rec>([&](const auto& f) {
+        if (!field_isInput(f.flags)) return;
+        const string& c = cols[i++];
+        if (!c.empty()) value_parse(c, r.*f.member);
+    });
+    return true;
+}
+
+// "<roll> <name> ..." for usage messages
+template <typename Rec>
+string schema_inputUsage() {
+    string out;
+    schema_forEach<Rec>([&](const auto& f) {
+        if (!field_isInput(f.flags)) return;
+        if (!out.empty()) out += ' ';
+        out += '<';
+        for (const char* c = f.label; *c; ++c) out += (char)std::tolower((unsigned char)*c);
+        out += '>';
+    });
+    return out;
+}
+
+template <typename Rec>
+void schema_encode(string& out, const Rec& r) {
+    schema_forEach<Rec>([&](const auto& f) { value_encode(out, r.*f.member); });
+}
+
+template <typename Rec>
+bool schema_decode(const char*& p, const char* end, Rec& r) {
+    bool ok = true;
+    schema_forEach<Rec>([&](const auto& f) { ok = ok && value_decode(p, end, r.*f.member); });
+    return ok;
+}
+
+// copy every non-key field (used by update)
+template <typename Rec>
+void schema_assignNonKey(Rec& dst, const Rec& src) {
+    schema_forEach<Rec>([&](const auto& f) {
+        if (!(f.flags & FIELD_KEY)) dst.*f.member = src.*f.member;
+    });
+}
+
+template <typename Rec>
+bool schema_equal(const Rec& a, const Rec& b) {
+    bool eq = true;
+    schema_forEach<Rec>([&](const auto& f) { eq = eq && (a.*f.member == b.*f.member); });
+    return eq;
+}
+
+// lexicographic over fields in schema order (so by key first)
+template <typename Rec>
+bool schema_less(const Rec& a, const Rec& b) {
+    int cmp = 0;
+    schema_forEach<Rec>([&](const auto& f) {
+        if (cmp != 0) return;
+        if (a.*f.member < b.*f.member)      cmp = -1;
+        else if (b.*f.member < a.*f.member) cmp = 1;
+    });
+    return cmp < 0;
+}
+
+static vector<Student> gStudents;
+static vector<Query>   gQueries;
+static int gNextQueryId = 1;
+
+// Rolls are unique. gStudents keeps insertion order for listings;
+// gRollIndex maps roll -> position in it. gNextRoll is above every roll
+// ever stored, archived or deleted ones included, so generated rolls
+// never collide with them.
+static std::unordered_map<int, size_t> gRollIndex;
+static int gNextRoll = 1;
+
+Student* findStudent(int roll) {
+    auto it = gRollIndex.find(roll);
+    return it == gRollIndex.end() ? nullptr : &gStudents[it->second];
+}
+
+// caller has checked the roll is not on record
+void students_insert(const Student& s) {
+    if (s.roll >= gNextRoll) gNextRoll = s.roll + 1;
+    gRollIndex[s.roll] = gStudents.size();
+    gStudents.push_back(s);
+}
+
+void students_reindex() {
+    gRollIndex.clear();
+    gRollIndex.reserve(gStudents.size());
+    for (size_t i = 0; i < gStudents.size(); ++i) {
+        gRollIndex[gStudents[i].roll] = i;
+        if (gStudents[i].roll >= gNextRoll) gNextRoll = gStudents[i].roll + 1;
+    }
+}
+
+bool students_erase(int roll) {
+    auto it = gRollIndex.find(roll);
+    if (it == gRollIndex.end()) return false;
+    size_t pos = it->second;
+    gRollIndex.erase(it);
+    gStudents.erase(gStudents.begin() + (std::ptrdiff_t)pos);
+    for (size_t i = pos; i < gStudents.size(); ++i)
+        gRollIndex[gStudents[i].roll] = i;
+    return true;
+}
+
+struct SemesterResult;
+
+// Mutation hooks for log-shipping replication (see REPLICATION below).
+// Every successful write calls one; they do nothing unless we are a leader.
+void repl_logStudent(const Student& s);
+void repl_logDeleteStudent(int roll);
+void repl_logQuery(const Query& q);
+void repl_logHistory(int roll, const SemesterResult& r);
+
+// Cold-tier fallbacks and replication hooks (see COLD ARCHIVE below).
+bool archive_findStudent(int roll, Student& out, vector<SemesterResult>& hist);
+bool archive_findQuery(int id, Query& out);
+bool archive_findStudentByName(const string& name, int& roll);
+bool archive_hasStudent(int roll);
+void archive_forgetStudent(int roll);
+Student* archive_restoreStudent(int roll);
+void archive_encodeIndex(string& out);
+bool archive_decodeIndex(const char*& p, const char* end);
+bool archive_applyRun(const char*& p, const char* end);
+
+// ======================== TRACE RECORDER ========================
+// With a trace open (--trace <file>), every outermost backend_* call is
+// appended to it as
+//   [varint us since the previous call started][u8 op][varint duration ns][args]
+// after an 8-byte magic whose last character is the format version. Args
+// are value_encode'd in parameter order (records through their schema, so
+// adding a field is a new version). Nested calls (update resolving
+// queries, search adding a student) belong to their caller and are not
+// recorded again. The load replay harness further down re-issues the calls.
+// Recording happens on the calling (GUI) thread only.
+
+enum TraceOp : uint8_t {
+    TR_ADD_STUDENT = 1,
+    TR_UPDATE_STUDENT,
+    TR_DELETE_STUDENT,
+    TR_SEARCH_NAME,
+    TR_GET_STUDENT,
+    TR_LIST_STUDENTS,
+    TR_ADD_QUERY,
+    TR_LIST_QUERIES,
+    TR_FILTER_STUDENTS,
+    TR_FILTER_QUERIES,
+    TR_SEM_RESULT,
+    TR_RESOLVE_QUERY,
+    TR_JOINED_QUERIES,
+    TR_FALLING_CGPA,
+    TR_GET_QUERY
+};
+
+static const char TRACE_MAGIC[] = "SRMSTRC2";   // 2: Student.updatedAt
+
+struct TraceRecorder {
+    FILE*    file        = nullptr;    // null = not recording
+    uint64_t lastStartUs = 0;
+    uint64_t records     = 0;
+    int      depth       = 0;          // nesting of backend_* calls
+};
+
+static TraceRecorder gTrace;
+
+inline uint64_t steady_ns() {
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+inline void trace_args(string&) {}
+
+template <typename T, typename... Rest>
+void trace_args(string& out, const T& v, const Rest&... rest) {
+    value_encode(out, v);
+    trace_args(out, rest...);
+}
+
+// whole records go in as schema_encode'd
+template <typename... Rest>
+void trace_args(string& out, const Student& s, const Rest&... rest) {
+    schema_encode(out, s);
+    trace_args(out, rest...);
+}
+
+// Put one at the top of a backend_* function, with its arguments.
+class TraceScope {
+public:
+    template <typename... Args>
+    explicit TraceScope(TraceOp op, const Args&... args) {
+        if (gTrace.file && gTrace.depth == 0) {
+            active_ = true;
+            op_     = op;
+            trace_args(args_, args...);
+            startNs_ = steady_ns();
+        }
+        ++gTrace.depth;
+    }
+
+    ~TraceScope() {
+        --gTrace.depth;
+        if (!active_ || !gTrace.file) return;
+        uint64_t endNs   = steady_ns();
+        uint64_t startUs = startNs_ / 1000;
+
+        string rec;
+        put_varint(rec, gTrace.records ? startUs - gTrace.lastStartUs : 0);
+        rec.push_back((char)op_);
+        put_varint(rec, endNs - startNs_);
+        rec.append(args_);
+        std::fwrite(rec.data(), 1, rec.size(), gTrace.file);
+
+        gTrace.lastStartUs = startUs;
+        ++gTrace.records;
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    bool     active_  = false;
+    TraceOp  op_      = TR_ADD_STUDENT;
+    uint64_t startNs_ = 0;
+    string   args_;
+};
+
+bool trace_start(const string& path) {
+    gTrace.file = std::fopen(path.c_str(), "wb");
+    if (!gTrace.file) return false;
+    std::fwrite(TRACE_MAGIC, 1, 8, gTrace.file);
+    gTrace.records = 0;
+    return true;
+}
+
+void trace_stop() {
+    if (gTrace.file) std::fclose(gTrace.file);
+    gTrace.file = nullptr;
+}
+
+// ======================== ACADEMIC HISTORY ========================
+// One entry per completed semester, per student. Entries are append-only and
+// kept as columns of zig-zag varints: semester and SGPA (in hundredths) as
+// deltas from the previous entry, credits as-is, grades one char each. A
+// typical entry costs ~4 bytes. Running totals make the derived CGPA and the
+// "CGPA fell N semesters running" streak O(1) per append, so trend reports
+// scan one small struct per student instead of decoding history.
+
+struct SemesterResult {
+    int   sem;
+    float sgpa;
+    int   credits;
+    char  grade;
+};
+
+const int MAX_SEM_CREDITS = 60;    // per semester; the GUI form records 20
+
+struct HistoryColumns {
+    string semDeltas;
+    string sgpaDeltas;
+    string credits;
+    string grades;                 // entry count == grades.size()
+
+    int       lastSem     = 0;     // bases for the next delta
+    int       lastSgpa100 = 0;
+    long long points100   = 0;     // sum(sgpa100 * credits)
+    long long totalCredits = 0;
+    float     cgpa         = 0.0f;
+    int       fallStreak   = 0;    // consecutive appends that lowered CGPA
+};
+
+static std::unordered_map<int, HistoryColumns> gHistory;   // by roll
+
+inline uint64_t zigzag(int64_t v)  { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+inline int64_t  unzigzag(uint64_t u) { return (int64_t)(u >> 1) ^ -(int64_t)(u & 1); }
+
+// Appends one semester and returns the new cumulative CGPA.
+float history_append(HistoryColumns& h, const SemesterResult& r) {
+    int sgpa100 = (int)std::lround(r.sgpa * 100.0f);
+    put_varint(h.semDeltas,  zigzag(r.sem - h.lastSem));
+    put_varint(h.sgpaDeltas, zigzag(sgpa100 - h.lastSgpa100));
+    put_varint(h.credits,    (uint64_t)r.credits);
+    h.grades.push_back(r.grade);
+    h.lastSem     = r.sem;
+    h.lastSgpa100 = sgpa100;
+
+    float prev = h.cgpa;
+    h.points100    += (long long)sgpa100 * r.credits;
+    h.totalCredits += r.credits;
+    h.cgpa = std::lround((double)h.points100 / h.totalCredits) / 100.0f;   // 2 decimals
+
+    if (h.grades.size() >= 2 && h.cgpa < prev) ++h.fallStreak;
+    else                                       h.fallStreak = 0;
+    return h.cgpa;
+}
+
+vector<SemesterResult> history_decode(const HistoryColumns& h) {
+    vector<SemesterResult> out;
+    out.reserve(h.grades.size());
+    const char* ps = h.semDeltas.data();   const char* es = ps + h.semDeltas.size();
+    const char* pg = h.sgpaDeltas.data();  const char* eg = pg + h.sgpaDeltas.size();
+    const char* pc = h.credits.data();     const char* ec = pc + h.credits.size();
+    int sem = 0, sgpa100 = 0;
+    for (char grade : h.grades) {
+        uint64_t ds, dg, cr;
+        if (!get_varint(ps, es, ds) || !get_varint(pg, eg, dg) || !get_varint(pc, ec, cr))
+            break;
+        sem     += (int)unzigzag(ds);
+        sgpa100 += (int)unzigzag(dg);
+        out.push_back(SemesterResult{sem, sgpa100 / 100.0f, (int)cr, grade});
+    }
+    return out;
+}
+
+// Records a completed semester. Semesters must be added in increasing order;
+// the student's sem, grade and CGPA are then taken from the history.
+bool backend_addSemesterResult(int roll, int sem, float sgpa, int credits, char grade) {
+    TraceScope trace(TR_SEM_RESULT, roll, sem, sgpa, credits, grade);
+    if (sem <= 0 || credits <= 0 || credits > MAX_SEM_CREDITS || !(sgpa >= 0.0f && sgpa <= 10.0f))
+        return false;
+    Student* s = findStudent(roll);
+    if (!s) s = archive_restoreStudent(roll);
+    if (!s) return false;
+    HistoryColumns& h = gHistory[roll];
+    if (!h.grades.empty() && sem <= h.lastSem)
+        return false;
+    const SemesterResult r{sem, sgpa, credits, grade};
+    s->cgpa  = history_append(h, r);
+    s->sem   = sem;
+    s->grade = grade;
+    s->updatedAt = now_s();
+    repl_logHistory(roll, r);
+    repl_logStudent(*s);
+    return true;
+}
+
+vector<SemesterResult> backend_getHistory(int roll) {
+    auto it = gHistory.find(roll);
+    if (it == gHistory.end()) return {};
+    return history_decode(it->second);
+}
+
+// ======================== QUERY SLA (TIMER WHEEL) ========================
+// Every open query has an escalation deadline in a hierarchical timer wheel:
+// 4 levels x 64 slots of 1-second ticks, covering ~194 days before a timer has
+// to be re-armed. Scheduling and cancelling are O(1) through an intrusive
+// list in a node pool. Each tick only touches the slot that falls due (and,
+// every 64^k ticks, cascades one slot of level k down), so hundreds of
+// thousands of open queries never need a scan of gQueries.
+
+class TimerWheel {
+public:
+    static const int      LEVELS    = 4;
+    static const int      SLOT_BITS = 6;
+    static const int      SLOTS     = 1 << SLOT_BITS;
+    static const uint64_t MAX_SPAN  = (uint64_t)1 << (SLOT_BITS * LEVELS);
+
+    TimerWheel() {
+        for (auto& level : heads_)
+            for (int& h : level) h = -1;
+    }
+
+    bool     started() const { return now_ != 0; }
+    uint64_t now() const     { return now_; }
+    void     start(uint64_t t) { if (!now_) now_ = t; }
+
+    // returns a handle for cancel()
+    int schedule(uint64_t expires, int payload) {
+        int n;
+        if (free_ >= 0) { n = free_; free_ = nodes_[n].next; }
+        else            { n = (int)nodes_.size(); nodes_.push_back(Node()); }
+        nodes_[n].expires = expires;
+        nodes_[n].payload = payload;
+        insert(n, now_ + 1);        // the current tick has already run
+        ++size_;
+        return n;
+    }
+
+    void cancel(int n) {
+        unlink(n);
+        nodes_[n].next = free_;
+        free_ = n;
+        --size_;
+    }
+
+    size_t size() const { return size_; }
+
+    // advances the wheel to time t, calling fire(payload) for every timer due
+    template <typename Fn>
+    void advance(uint64_t t, Fn fire) {
+        while (now_ < t) {
+            ++now_;
+            // cascade: at each level boundary, redistribute the next coarse slot
+            for (int l = 1; l < LEVELS; ++l) {
+                if ((now_ >> (SLOT_BITS * l)) << (SLOT_BITS * l) != now_) break;
+                int slot = (int)((now_ >> (SLOT_BITS * l)) & (SLOTS - 1));
+                int n = heads_[l][slot];
+                heads_[l][slot] = -1;
+                while (n >= 0) {
+                    int next = nodes_[n].next;
+                    insert(n, now_);
+                    n = next;
+                }
+            }
+
+            int slot = (int)(now_ & (SLOTS - 1));
+            while (heads_[0][slot] >= 0) {
+                int n = heads_[0][slot];
+                unlink(n);
+                if (nodes_[n].expires > now_) {     // beyond MAX_SPAN: re-arm
+                    insert(n, now_ + 1);
+                    continue;
+                }
+                int payload = nodes_[n].payload;
+                nodes_[n].next = free_;
+                free_ = n;
+                --size_;
+                fire(payload);
+            }
+        }
+    }
+
+private:
+    struct Node {
+        uint64_t expires = 0;
+        int      payload = 0;
+        int      level = 0, slot = 0;
+        int      prev = -1, next = -1;
+    };
+
+    // earliest = first tick the timer may still fire on
+    void insert(int n, uint64_t earliest) {
+        Node& x = nodes_[n];
+        uint64_t at    = std::max(x.expires, earliest);
+        uint64_t delta = std::min(at - now_, MAX_SPAN - 1);
+        at = now_ + delta;
+        int l = 0;
+        while (l < LEVELS - 1 && delta >= ((uint64_t)1 << (SLOT_BITS * (l + 1)))) ++l;
+        x.level = l;
+        x.slot  = (int)((at >> (SLOT_BITS * l)) & (SLOTS - 1));
+        x.prev  = -1;
+        x.next  = heads_[l][x.slot];
+        if (x.next >= 0) nodes_[x.next].prev = n;
+        heads_[l][x.slot] = n;
+    }
+
+    void unlink(int n) {
+        Node& x = nodes_[n];
+        if (x.prev >= 0) nodes_[x.prev].next = x.next;
+        else             heads_[x.level][x.slot] = x.next;
+        if (x.next >= 0) nodes_[x.next].prev = x.prev;
+    }
+
+    uint64_t     now_  = 0;
+    int          heads_[LEVELS][SLOTS];
+    vector<Node> nodes_;
+    int          free_ = -1;
+    size_t       size_ = 0;
 };
 
-static vector<Student> gStudents;
-static vector<Query>   gQueries;
-static int gNextQueryId = 1;
+const long long QUERY_SLA_SECONDS = 48 * 60 * 60;   // Pending -> Escalated
+
+static TimerWheel gSlaWheel;
+static std::unordered_map<int, int> gSlaTimers;     // query id -> wheel handle
+static std::unordered_map<int, vector<int>> gOpenByRoll;   // roll -> unresolved query ids
+static vector<string> gNotifications;               // drained by the GUI
+
+// gQueries is append-only in id order, so lookups by id are a binary search
+Query* findQuery(int id) {
+    auto it = std::lower_bound(gQueries.begin(), gQueries.end(), id,
+                               [](const Query& q, int v) { return q.id < v; });
+    return (it != gQueries.end() && it->id == id) ? &*it : nullptr;
+}
+
+// a new query is open until resolved; escalation keeps it open
+void sla_arm(const Query& q) {
+    gSlaWheel.start((uint64_t)now_s());
+    gSlaTimers[q.id] = gSlaWheel.schedule((uint64_t)(q.submittedAt + QUERY_SLA_SECONDS), q.id);
+    gOpenByRoll[q.roll].push_back(q.id);
+}
+
+void sla_disarm(const Query& q) {
+    auto it = gSlaTimers.find(q.id);
+    if (it != gSlaTimers.end()) {
+        gSlaWheel.cancel(it->second);
+        gSlaTimers.erase(it);
+    }
+    auto open = gOpenByRoll.find(q.roll);
+    if (open == gOpenByRoll.end()) return;
+    vector<int>& ids = open->second;
+    ids.erase(std::remove(ids.begin(), ids.end(), q.id), ids.end());
+    if (ids.empty()) gOpenByRoll.erase(open);
+}
+
+void sla_escalate(int id) {
+    gSlaTimers.erase(id);
+    Query* q = findQuery(id);
+    if (!q || q->status != "Pending") return;
+    q->status    = "Escalated";
+    q->updatedAt = now_s();
+    repl_logQuery(*q);
+    gNotifications.push_back("Query " + std::to_string(q->id) + " (roll " +
+                             std::to_string(q->roll) + ", " + q->name +
+                             ") unresolved for 48h - escalated.");
+}
+
+// runs every escalation that fell due up to time t (unix seconds)
+void sla_advance(long long t) {
+    if (gSlaWheel.started())
+        gSlaWheel.advance((uint64_t)t, sla_escalate);
+}
+
+bool backend_resolveQuery(int id) {
+    TraceScope trace(TR_RESOLVE_QUERY, id);
+    Query* q = findQuery(id);
+    if (!q) return false;
+    if (q->status != "Resolved") {
+        sla_disarm(*q);
+        q->status    = "Resolved";
+        q->updatedAt = now_s();
+        repl_logQuery(*q);
+    }
+    return true;
+}
+
+vector<string> backend_takeNotifications() {
+    vector<string> out;
+    out.swap(gNotifications);
+    return out;
+}
+
+void backend_init() {
+    // currently nothing
+}
+
+bool backend_addStudent(const Student& s) {
+    TraceScope trace(TR_ADD_STUDENT, s);
+    if (s.roll <= 0 || s.name.empty() || s.dept.empty() || !(s.cgpa >= 0.0f && s.cgpa <= 10.0f) ||
+        findStudent(s.roll) || archive_hasStudent(s.roll))
+        return false;    // archived rolls stay taken
+
+    Student rec = s;
+    rec.updatedAt = now_s();
+    students_insert(rec);
+    repl_logStudent(rec);
+    return true;
+}
+
+// update student (admin can correct details after checking queries);
+// every non-key field of upd replaces the stored one, except that sem, CGPA
+// and grade of a student with semester results stay as the history has
+// them. Resubmitting the stored values writes nothing (no log frame,
+// updatedAt kept).
+bool backend_updateStudent(const Student& upd) {
+    TraceScope trace(TR_UPDATE_STUDENT, upd);
+    const int roll = upd.roll;
+    if (!(upd.cgpa >= 0.0f && upd.cgpa <= 10.0f)) return false;
+    Student* s = findStudent(roll);
+    if (!s) s = archive_restoreStudent(roll);
+    if (!s) return false;  // not found
+
+    Student next = *s;
+    schema_assignNonKey(next, upd);
+    next.updatedAt = s->updatedAt;       // not an input column
+    auto h = gHistory.find(roll);
+    if (h != gHistory.end() && !h->second.grades.empty()) {
+        next.sem   = s->sem;
+        next.cgpa  = s->cgpa;
+        next.grade = s->grade;
+    }
+    if (!schema_equal(next, *s)) {
+        next.updatedAt = now_s();
+        *s = next;
+        repl_logStudent(*s);
+    }
+    // the admin acted on this student: their open queries are answered
+    auto open = gOpenByRoll.find(roll);
+    if (open != gOpenByRoll.end()) {
+        const vector<int> ids = open->second;    // resolving edits the list
+        for (int id : ids)
+            backend_resolveQuery(id);
+    }
+    return true;
+}
+
+// delete student by roll (an archived one is only dropped from the archive index)
+bool backend_deleteStudent(int roll) {
+    TraceScope trace(TR_DELETE_STUDENT, roll);
+    if (students_erase(roll))          gHistory.erase(roll);
+    else if (archive_hasStudent(roll)) archive_forgetStudent(roll);
+    else                               return false;
+    repl_logDeleteStudent(roll);
+    return true;
+}
+
+int backend_addStudentNameOnly(const string& name) {
+    while (findStudent(gNextRoll) || archive_hasStudent(gNextRoll))
+        ++gNextRoll;
+    int newRoll = gNextRoll;
+
+    Student s{};
+    s.roll  = newRoll;
+    s.name  = name;
+    s.dept  = "N/A";
+    s.grade = '-';
+    s.updatedAt = now_s();
+
+    students_insert(s);
+    repl_logStudent(s);
+    return newRoll;
+}
+
+int backend_searchNameOrAdd(const string& name, bool &wasAdded) {
+    TraceScope trace(TR_SEARCH_NAME, name);
+    wasAdded = false;
+    for (const auto& s : gStudents) {
+        if (s.name == name) {
+            return s.roll;     // existing student
+        }
+    }
+    int roll;
+    if (archive_findStudentByName(name, roll))
+        return roll;
+    wasAdded = true;
+    return backend_addStudentNameOnly(name);
+}
+
+string format_studentDetail(const Student& s, const vector<SemesterResult>& hist, bool archived) {
+    TableWriter tw(schema_detailBound(s) + 64 + hist.size() * (3 * INT_CHARS + FLOAT_CHARS + 32));
+    schema_detail(tw, s);
+    if (!hist.empty()) {
+        tw.text("\r\n\r\nHistory:");
+        for (const auto& r : hist) {
+            tw.text("\r\n  Sem ");
+            tw.cell(r.sem, 3);
+            tw.text("SGPA ");
+            tw.cell(r.sgpa, 6);
+            tw.cell(r.credits, 0);
+            tw.text(" cr  ");
+            tw.cell(r.grade, 0);
+        }
+    }
+    if (archived)
+        tw.text("\r\n\r\n(archived record)");
+    return tw.take();
+}
+
+string backend_getStudentByRoll(int roll) {
+    TraceScope trace(TR_GET_STUDENT, roll);
+    if (const Student* hot = findStudent(roll))
+        return format_studentDetail(*hot, backend_getHistory(roll), false);
+    Student s;
+    vector<SemesterResult> hist;
+    if (archive_findStudent(roll, s, hist))
+        return format_studentDetail(s, hist, true);
+    return "Student not found.";
+}
+
+// copy of a hot or archived student's record (the GUI pre-fills an update
+// with it); not a traced call
+bool store_getStudent(int roll, Student& out) {
+    if (const Student* s = findStudent(roll)) {
+        out = *s;
+        return true;
+    }
+    vector<SemesterResult> hist;
+    return archive_findStudent(roll, out, hist);
+}
+
+static const char TABLE_RULE[] =
+    "---------------------------------------------------------------------\r\n";
+
+const char* cgpaStatus(float cgpa) {
+    if (cgpa >= 8.0f) return "Excellent";
+    if (cgpa >= 7.0f) return "Very Good";
+    if (cgpa >= 6.0f) return "Good";
+    if (cgpa >= 5.0f) return "Average";
+    return "Needs Help";
+}
+
+// Student table for n rows, row(i) -> const Student&. Sized in one pass,
+// written in a second, so the output string is allocated exactly once.
+template <typename RowFn>
+string format_studentTable(size_t n, RowFn row,
+                           const char* emptyMsg = "(No students added yet)\r\n") {
+    const size_t statusBound = 10 + 2;   // "Needs Help" + \r\n
+    size_t cap = schema_headerBound<Student>() + 6 + 2 + sizeof TABLE_RULE + 32;
+    for (size_t i = 0; i < n; ++i)
+        cap += schema_rowBound(row(i)) + statusBound;
+
+    TableWriter tw(cap);
+    // header
+    schema_header<Student>(tw);
+    tw.text("STATUS");
+    tw.newline();
+
+    tw.text(TABLE_RULE);
+
+    if (n == 0) {
+        tw.text(emptyMsg);
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            const Student& s = row(i);
+            schema_row(tw, s);
+            tw.text(cgpaStatus(s.cgpa));
+            tw.newline();
+        }
+    }
+    return tw.take();
+}
+
+string backend_getAllStudents() {
+    TraceScope trace(TR_LIST_STUDENTS);
+    return format_studentTable(gStudents.size(),
+                               [](size_t i) -> const Student& { return gStudents[i]; });
+}
+
+int backend_addQuery(int roll,
+                     const string& name,
+                     const string& message) {
+    TraceScope trace(TR_ADD_QUERY, roll, name, message);
+    if (roll <= 0 || name.empty() || message.empty())
+        return -1;
+    if (!findStudent(roll))
+        archive_restoreStudent(roll);     // a graduate writing in is active again
+
+    Query q;
+    q.id      = gNextQueryId++;
+    q.roll    = roll;
+    q.name    = name;
+    q.message = message;
+    q.status  = "Pending";
+    q.submittedAt = q.updatedAt = now_s();
+
+    gQueries.push_back(q);
+    sla_arm(q);
+    repl_logQuery(q);
+    return q.id;
+}
+
+string backend_getQueryById(int id) {
+    TraceScope trace(TR_GET_QUERY, id);
+    Query archived;
+    const Query* q = findQuery(id);
+    if (!q && archive_findQuery(id, archived))
+        q = &archived;
+    if (!q)
+        return "Query not found.";
+
+    TableWriter tw(schema_detailBound(*q) + 32);
+    schema_detail(tw, *q);
+    if (q == &archived)
+        tw.text("\r\n\r\n(archived record)");
+    return tw.take();
+}
+
+// Students whose cumulative CGPA dropped in each of their last `runs`
+// semesters (e.g. runs = 2: "fell two semesters running").
+string backend_getFallingCgpa(int runs) {
+    TraceScope trace(TR_FALLING_CGPA, runs);
+    vector<const Student*> rows;
+    for (const auto& s : gStudents) {
+        auto it = gHistory.find(s.roll);
+        if (it != gHistory.end() && it->second.fallStreak >= runs)
+            rows.push_back(&s);
+    }
+    return format_studentTable(rows.size(),
+                               [&](size_t i) -> const Student& { return *rows[i]; },
+                               "(No students with a falling CGPA)\r\n");
+}
+
+template <typename RowFn>
+string format_queryTable(size_t n, RowFn row,
+                         const char* emptyMsg = "(No queries submitted yet)\r\n") {
+    size_t cap = schema_headerBound<Query>() + 2 + sizeof TABLE_RULE + 32;
+    for (size_t i = 0; i < n; ++i)
+        cap += schema_rowBound(row(i)) + 2;
+
+    TableWriter tw(cap);
+    schema_header<Query>(tw);
+    tw.newline();
+
+    tw.text(TABLE_RULE);
+
+    if (n == 0) {
+        tw.text(emptyMsg);
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            schema_row(tw, row(i));
+            tw.newline();
+        }
+    }
+    return tw.take();
+}
+
+string backend_getAllQueries() {
+    TraceScope trace(TR_LIST_QUERIES);
+    return format_queryTable(gQueries.size(),
+                             [](size_t i) -> const Query& { return gQueries[i]; });
+}
+
+// ======================== JOINED QUERY VIEW ========================
+// Lists queries next to the current record of the student they name. A
+// listing is a hash join on roll: gQueries streams through gRollIndex (kept
+// up to date alongside gStudents) in id order, so a page costs O(page size)
+// and the full joined list is never materialized. Each row is checked: the
+// roll must be on record, and the name typed with the query must match the
+// student's name. A recent query of an archived student shows as such.
+// Shared columns take their layout from the two schemas.
+
+enum JoinCheck { JOIN_OK, JOIN_NAME_MISMATCH, JOIN_ARCHIVED, JOIN_UNKNOWN_ROLL };
+
+struct JoinedQuery {
+    const Query*   query;
+    const Student* student;     // null when the roll is not on record
+    JoinCheck      check;
+};
+
+// ignores case and surrounding spaces
+bool join_sameName(const string& a, const string& b) {
+    size_t ab = a.find_first_not_of(' '), ae = a.find_last_not_of(' ');
+    size_t bb = b.find_first_not_of(' '), be = b.find_last_not_of(' ');
+    if (ab == string::npos || bb == string::npos) return ab == bb;
+    if (ae - ab != be - bb) return false;
+    for (size_t i = 0; i <= ae - ab; ++i)
+        if (std::tolower((unsigned char)a[ab + i]) != std::tolower((unsigned char)b[bb + i]))
+            return false;
+    return true;
+}
+
+// Streams joined rows for gQueries[offset, offset + limit) to emit(row);
+// returns how many were emitted.
+template <typename Fn>
+size_t join_forEach(size_t offset, size_t limit, Fn emit) {
+    if (offset >= gQueries.size()) return 0;
+    size_t end = offset + std::min(limit, gQueries.size() - offset);
+    for (size_t i = offset; i < end; ++i) {
+        const Query& q = gQueries[i];
+        JoinedQuery row{&q, findStudent(q.roll), JOIN_UNKNOWN_ROLL};
+        if (row.student)
+            row.check = join_sameName(q.name, row.student->name) ? JOIN_OK : JOIN_NAME_MISMATCH;
+        else if (archive_hasStudent(q.roll))
+            row.check = JOIN_ARCHIVED;
+        emit(row);
+    }
+    return end - offset;
+}
+
+const char* joinCheckText(JoinCheck c) {
+    switch (c) {
+    case JOIN_OK:            return "ok";
+    case JOIN_NAME_MISMATCH: return "NAME?";
+    case JOIN_ARCHIVED:      return "ARCHIVED";
+    default:                 return "NO ROLL";
+    }
+}
+
+// One page (0-based) of the joined listing.
+string backend_getJoinedQueries(size_t page, size_t pageSize) {
+    TraceScope trace(TR_JOINED_QUERIES, (long long)page, (long long)pageSize);
+    if (pageSize == 0) pageSize = 1;
+    size_t pages = std::max((size_t)1, (gQueries.size() + pageSize - 1) / pageSize);
+    if (page >= pages) page = pages - 1;
+    size_t offset = page * pageSize;
+    size_t rows   = offset < gQueries.size() ? std::min(pageSize, gQueries.size() - offset) : 0;
+
+    const SchemaColumn cId     = schema_column(&Query::id);
+    const SchemaColumn cRoll   = schema_column(&Query::roll);
+    const SchemaColumn cName   = schema_column(&Query::name);
+    const SchemaColumn cDept   = schema_column(&Student::dept);
+    const SchemaColumn cSem    = schema_column(&Student::sem);
+    const SchemaColumn cCgpa   = schema_column(&Student::cgpa);
+    const SchemaColumn cStatus = schema_column(&Query::status);
+    const SchemaColumn cCheck  = {"CHECK", 9, 0};
+    const SchemaColumn cSubmit = schema_column(&Query::submittedAt);
+    const SchemaColumn cMsg    = schema_column(&Query::message);
+
+    size_t cap = 256 + sizeof TABLE_RULE;
+    join_forEach(offset, rows, [&](const JoinedQuery& r) {
+        const Query& q = *r.query;
+        cap += column_bound(cId, q.id) + column_bound(cRoll, q.roll) + column_bound(cName, q.name) +
+               column_bound(cStatus, q.status) + column_bound(cCheck, joinCheckText(r.check)) +
+               column_bound(cSubmit, q.submittedAt) + column_bound(cMsg, q.message) + 2;
+        cap += r.student ? column_bound(cDept, r.student->dept) + column_bound(cSem, r.student->sem) +
+                           column_bound(cCgpa, r.student->cgpa)
+                         : column_bound(cDept, "-") + column_bound(cSem, "-") + column_bound(cCgpa, "-");
+    });
+
+    TableWriter tw(cap);
+    tw.text("Page ");
+    tw.cell((int)(page + 1), 0);
+    tw.text(" of ");
+    tw.cell((int)pages, 0);
+    tw.text("  (");
+    tw.cell((int)gQueries.size(), 0);
+    tw.text(" queries)\r\n");
+
+    for (const SchemaColumn* c : {&cId, &cRoll, &cName, &cDept, &cSem, &cCgpa, &cStatus, &cCheck, &cSubmit, &cMsg})
+        column_header(tw, *c);
+    tw.newline();
+    tw.text(TABLE_RULE);
+
+    if (rows == 0) {
+        tw.text("(No queries submitted yet)\r\n");
+        return tw.take();
+    }
+
+    join_forEach(offset, rows, [&](const JoinedQuery& r) {
+        const Query& q = *r.query;
+        column_cell(tw, cId, q.id);
+        column_cell(tw, cRoll, q.roll);
+        column_cell(tw, cName, q.name);
+        if (r.student) {
+            column_cell(tw, cDept, r.student->dept);
+            column_cell(tw, cSem, r.student->sem);
+            column_cell(tw, cCgpa, r.student->cgpa);
+        } else {
+            column_cell(tw, cDept, "-");
+            column_cell(tw, cSem, "-");
+            column_cell(tw, cCgpa, "-");
+        }
+        column_cell(tw, cStatus, q.status);
+        column_cell(tw, cCheck, joinCheckText(r.check));
+        column_cell(tw, cSubmit, q.submittedAt);
+        column_cell(tw, cMsg, q.message);
+        tw.newline();
+    });
+    return tw.take();
+}
+
+// ======================== FILTER LANGUAGE ========================
+// Ad-hoc report filters over students (or queries), e.g.
+//
+//   dept == "CSE" && sem >= 5 && cgpa < 6.0 && grade != 'A' order by cgpa desc limit 20
+//
+// Field names are the schema column headers, in any case. Supported syntax:
+// == != < <= > >=, &&, ||, !, and parentheses. Literals are numbers,
+// "strings" and 'c' chars. The text is parsed once into a tree of typed
+// stages. A run walks the records in batches of FILTER_BATCH; each
+// comparison narrows the batch's selection vector with a tight loop over one
+// field, so virtual dispatch happens per batch, not per record.
+
+constexpr size_t FILTER_BATCH = 1024;
+typedef vector<uint32_t> Selection;   // ascending indexes into the current batch
+
+template <typename Rec>
+struct FilterStage {
+    virtual ~FilterStage() {}
+    virtual void apply(const Rec* batch, Selection& sel) const = 0;
+};
+
+template <typename Rec, typename T, typename Op>
+struct CompareStage : FilterStage<Rec> {
+    T Rec::* member;
+    T        value;
+    CompareStage(T Rec::* m, T v) : member(m), value(std::move(v)) {}
+
+    void apply(const Rec* batch, Selection& sel) const override {
+        Op op;
+        size_t k = 0;
+        for (uint32_t i : sel)
+            if (op(batch[i].*member, value)) sel[k++] = i;
+        sel.resize(k);
+    }
+};
+
+template <typename Rec>
+struct AndStage : FilterStage<Rec> {
+    std::unique_ptr<FilterStage<Rec>> lhs, rhs;
+    void apply(const Rec* batch, Selection& sel) const override {
+        lhs->apply(batch, sel);
+        if (!sel.empty()) rhs->apply(batch, sel);
+    }
+};
+
+template <typename Rec>
+struct OrStage : FilterStage<Rec> {
+    std::unique_ptr<FilterStage<Rec>> lhs, rhs;
+    void apply(const Rec* batch, Selection& sel) const override {
+        Selection a = sel, b = sel;
+        lhs->apply(batch, a);
+        rhs->apply(batch, b);
+        sel.clear();
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(sel));
+    }
+};
+
+template <typename Rec>
+struct NotStage : FilterStage<Rec> {
+    std::unique_ptr<FilterStage<Rec>> inner;
+    void apply(const Rec* batch, Selection& sel) const override {
+        Selection hit = sel;
+        inner->apply(batch, hit);
+        Selection rest;
+        std::set_difference(sel.begin(), sel.end(), hit.begin(), hit.end(),
+                            std::back_inserter(rest));
+        sel.swap(rest);
+    }
+};
+
+template <typename Rec>
+struct OrderStage {
+    virtual ~OrderStage() {}
+    // sorts rows and keeps at most limit of them
+    virtual void sort(vector<const Rec*>& rows, size_t limit) const = 0;
+};
+
+template <typename Rec, typename T>
+struct OrderByField : OrderStage<Rec> {
+    T Rec::* member;
+    bool     desc;
+    OrderByField(T Rec::* m, bool d) : member(m), desc(d) {}
+
+    // Ties go by schema_less, i.e. by key, so the order is total and a
+    // limited sort returns exactly the head of the full one.
+    void sort(vector<const Rec*>& rows, size_t limit) const override {
+        auto cmp = [this](const Rec* a, const Rec* b) {
+            const T& x = a->*member;
+            const T& y = b->*member;
+            if (x < y) return !desc;
+            if (y < x) return desc;
+            return schema_less(*a, *b);
+        };
+        if (limit < rows.size()) {
+            std::partial_sort(rows.begin(), rows.begin() + limit, rows.end(), cmp);
+            rows.resize(limit);
+        } else {
+            std::sort(rows.begin(), rows.end(), cmp);
+        }
+    }
+};
+
+template <typename Rec>
+struct CompiledFilter {
+    std::unique_ptr<FilterStage<Rec>> where;   // null = every record
+    std::unique_ptr<OrderStage<Rec>>  order;   // null = storage order
+    size_t limit = (size_t)-1;
+};
+
+template <typename Rec>
+vector<const Rec*> filter_run(const CompiledFilter<Rec>& f, const vector<Rec>& recs) {
+    vector<const Rec*> out;
+    if (f.limit == 0) return out;
+
+    Selection sel;
+    sel.reserve(FILTER_BATCH);
+    for (size_t start = 0; start < recs.size(); start += FILTER_BATCH) {
+        const Rec* batch = recs.data() + start;
+        sel.resize(std::min(FILTER_BATCH, recs.size() - start));
+        std::iota(sel.begin(), sel.end(), 0u);
+        if (f.where) f.where->apply(batch, sel);
+
+        for (uint32_t i : sel) {
+            out.push_back(batch + i);
+            // without ordering, the first `limit` matches are the answer
+            if (!f.order && out.size() >= f.limit) return out;
+        }
+    }
+    if (f.order) f.order->sort(out, f.limit);
+    return out;
+}
+
+// ---- parser ----
+
+struct FilterToken {
+    enum Type { END, IDENT, NUMBER, STRING, CHAR, OP, LPAREN, RPAREN } type;
+    string text;
+    double num      = 0.0;
+    bool   integral = false;
+};
+
+inline bool iequals(const string& a, const char* b) {
+    size_t n = std::strlen(b);
+    if (a.size() != n) return false;
+    for (size_t i = 0; i < n; ++i)
+        if (std::tolower((unsigned char)a[i]) != std::tolower((unsigned char)b[i]))
+            return false;
+    return true;
+}
+
+// integer literal within T's range: [min, -min), both exact as doubles
+template <typename T>
+inline bool filter_integer(const FilterToken& t, T& v) {
+    const double lo = (double)std::numeric_limits<T>::min();
+    if (t.type != FilterToken::NUMBER || !t.integral || !(t.num >= lo && t.num < -lo))
+        return false;
+    v = (T)t.num;
+    return true;
+}
+inline bool filter_literal(const FilterToken& t, int& v)       { return filter_integer(t, v); }
+inline bool filter_literal(const FilterToken& t, long long& v) { return filter_integer(t, v); }
+inline bool filter_literal(const FilterToken& t, float& v) {
+    if (t.type != FilterToken::NUMBER || !(std::fabs(t.num) <= std::numeric_limits<float>::max()))
+        return false;
+    v = (float)t.num;
+    return true;
+}
+inline bool filter_literal(const FilterToken& t, char& v) {
+    if ((t.type != FilterToken::CHAR && t.type != FilterToken::STRING) || t.text.size() != 1)
+        return false;
+    v = t.text[0];
+    return true;
+}
+inline bool filter_literal(const FilterToken& t, string& v) {
+    if (t.type != FilterToken::STRING) return false;
+    v = t.text;
+    return true;
+}
+
+template <typename Rec>
+class FilterParser {
+public:
+    explicit FilterParser(const string& src) : src_(src) {}
+
+    bool parse(CompiledFilter<Rec>& out, string& err) {
+        if (!tokenize()) { err = err_; return false; }
+
+        if (!atKeyword("order") && !atKeyword("limit") && cur().type != FilterToken::END) {
+            out.where = parseOr();
+            if (!out.where) { err = err_; return false; }
+        }
+        if (atKeyword("order")) {
+            ++pos_;
+            if (!atKeyword("by")) { err = "expected 'by' after 'order'"; return false; }
+            ++pos_;
+            if (cur().type != FilterToken::IDENT) { err = "expected a field after 'order by'"; return false; }
+            string name = cur().text;
+            ++pos_;
+            bool desc = false;
+            if (atKeyword("desc"))     { desc = true; ++pos_; }
+            else if (atKeyword("asc")) { ++pos_; }
+            out.order = makeOrder(name, desc);
+            if (!out.order) { err = err_; return false; }
+        }
+        if (atKeyword("limit")) {
+            ++pos_;
+            if (cur().type != FilterToken::NUMBER || !cur().integral || cur().num < 0) {
+                err = "expected a row count after 'limit'";
+                return false;
+            }
+            // past size_t means no limit
+            out.limit = cur().num < (double)std::numeric_limits<size_t>::max()
+                            ? (size_t)cur().num : std::numeric_limits<size_t>::max();
+            ++pos_;
+        }
+        if (cur().type != FilterToken::END) {
+            err = "unexpected '" + cur().text + "'";
+            return false;
+        }
+        return true;
+    }
+
+private:
+    typedef std::unique_ptr<FilterStage<Rec>> StagePtr;
+
+    bool tokenize() {
+        size_t i = 0, n = src_.size();
+        while (i < n) {
+            char c = src_[i];
+            if (std::isspace((unsigned char)c)) { ++i; continue; }
+
+            FilterToken t;
+            if (std::isalpha((unsigned char)c) || c == '_') {
+                size_t j = i;
+                while (j < n && (std::isalnum((unsigned char)src_[j]) || src_[j] == '_')) ++j;
+                t.type = FilterToken::IDENT;
+                t.text = src_.substr(i, j - i);
+                i = j;
+            } else if (std::isdigit((unsigned char)c) || c == '.' ||
+                       (c == '-' && i + 1 < n && std::isdigit((unsigned char)src_[i + 1]))) {
+                char* end = nullptr;
+                t.type     = FilterToken::NUMBER;
+                t.num      = std::strtod(src_.c_str() + i, &end);
+                size_t j   = (size_t)(end - src_.c_str());
+                t.text     = src_.substr(i, j - i);
+                t.integral = t.text.find_first_of(".eE") == string::npos;
+                if (j == i) { err_ = "bad number"; return false; }
+                i = j;
+            } else if (c == '"' || c == '\'') {
+                size_t j = src_.find(c, i + 1);
+                if (j == string::npos) { err_ = "unterminated quote"; return false; }
+                t.type = (c == '"') ? FilterToken::STRING : FilterToken::CHAR;
+                t.text = src_.substr(i + 1, j - i - 1);
+                i = j + 1;
+            } else if (c == '(' || c == ')') {
+                t.type = (c == '(') ? FilterToken::LPAREN : FilterToken::RPAREN;
+                t.text = string(1, c);
+                ++i;
+            } else {
+                static const char* const ops[] = { "==", "!=", "<=", ">=", "&&", "||", "<", ">", "!" };
+                t.type = FilterToken::OP;
+                for (const char* op : ops) {
+                    size_t len = std::strlen(op);
+                    if (src_.compare(i, len, op) == 0) { t.text = op; break; }
+                }
+                if (t.text.empty()) { err_ = string("unexpected character '") + c + "'"; return false; }
+                i += t.text.size();
+            }
+            toks_.push_back(t);
+        }
+        toks_.push_back(FilterToken{FilterToken::END, "end of input"});
+        return true;
+    }
+
+    const FilterToken& cur() const { return toks_[pos_]; }
+    bool atOp(const char* op) const { return cur().type == FilterToken::OP && cur().text == op; }
+    bool atKeyword(const char* kw) const { return cur().type == FilterToken::IDENT && iequals(cur().text, kw); }
+
+    StagePtr fail(const string& msg) {
+        if (err_.empty()) err_ = msg;
+        return nullptr;
+    }
+
+    StagePtr parseOr() {
+        StagePtr lhs = parseAnd();
+        while (lhs && atOp("||")) {
+            ++pos_;
+            auto node = std::make_unique<OrStage<Rec>>();
+            node->lhs = std::move(lhs);
+            node->rhs = parseAnd();
+            if (!node->rhs) return nullptr;
+            lhs = std::move(node);
+        }
+        return lhs;
+    }
+
+    StagePtr parseAnd() {
+        StagePtr lhs = parseUnary();
+        while (lhs && atOp("&&")) {
+            ++pos_;
+            auto node = std::make_unique<AndStage<Rec>>();
+            node->lhs = std::move(lhs);
+            node->rhs = parseUnary();
+            if (!node->rhs) return nullptr;
+            lhs = std::move(node);
+        }
+        return lhs;
+    }
+
+    StagePtr parseUnary() {
+        if (atOp("!")) {
+            ++pos_;
+            auto node = std::make_unique<NotStage<Rec>>();
+            node->inner = parseUnary();
+            if (!node->inner) return nullptr;
+            return node;
+        }
+        if (cur().type == FilterToken::LPAREN) {
+            ++pos_;
+            StagePtr inner = parseOr();
+            if (!inner) return nullptr;
+            if (cur().type != FilterToken::RPAREN) return fail("expected ')'");
+            ++pos_;
+            return inner;
+        }
+        return parseCompare();
+    }
+
+    StagePtr parseCompare() {
+        if (cur().type != FilterToken::IDENT)
+            return fail("expected a field name, got '" + cur().text + "'");
+        string name = cur().text;
+        ++pos_;
+
+        static const char* const cmps[] = { "==", "!=", "<", "<=", ">", ">=" };
+        int op = -1;
+        for (int k = 0; k < 6; ++k)
+            if (atOp(cmps[k])) op = k;
+        if (op < 0) return fail("expected a comparison after '" + name + "'");
+        ++pos_;
+
+        const FilterToken& lit = cur();
+        if (lit.type == FilterToken::END) return fail("expected a value after '" + name + "'");
+        ++pos_;
+
+        StagePtr stage;
+        bool found = false;
+        schema_forEach<Rec>([&](const auto& f) {
+            if (found || !iequals(name, f.header)) return;
+            found = true;
+            stage = makeCompare(f.member, op, lit, name);
+        });
+        if (!found) return fail("unknown field '" + name + "'");
+        return stage;
+    }
+
+    template <typename T>
+    StagePtr makeCompare(T Rec::* member, int op, const FilterToken& lit, const string& name) {
+        T v{};
+        if (!filter_literal(lit, v))
+            return fail("'" + lit.text + "' is not a valid value for " + name);
+        switch (op) {
+        case 0:  return std::make_unique<CompareStage<Rec, T, std::equal_to<T>>>(member, v);
+        case 1:  return std::make_unique<CompareStage<Rec, T, std::not_equal_to<T>>>(member, v);
+        case 2:  return std::make_unique<CompareStage<Rec, T, std::less<T>>>(member, v);
+        case 3:  return std::make_unique<CompareStage<Rec, T, std::less_equal<T>>>(member, v);
+        case 4:  return std::make_unique<CompareStage<Rec, T, std::greater<T>>>(member, v);
+        default: return std::make_unique<CompareStage<Rec, T, std::greater_equal<T>>>(member, v);
+        }
+    }
+
+    std::unique_ptr<OrderStage<Rec>> makeOrder(const string& name, bool desc) {
+        std::unique_ptr<OrderStage<Rec>> order;
+        schema_forEach<Rec>([&](const auto& f) {
+            if (!order && iequals(name, f.header))
+                order = makeOrderBy(f.member, desc);
+        });
+        if (!order) err_ = "unknown field '" + name + "'";
+        return order;
+    }
+
+    template <typename T>
+    static std::unique_ptr<OrderStage<Rec>> makeOrderBy(T Rec::* member, bool desc) {
+        return std::make_unique<OrderByField<Rec, T>>(member, desc);
+    }
+
+    const string&       src_;
+    vector<FilterToken> toks_;
+    size_t              pos_ = 0;
+    string              err_;
+};
+
+template <typename Rec>
+bool filter_compile(const string& expr, CompiledFilter<Rec>& out, string& err) {
+    return FilterParser<Rec>(expr).parse(out, err);
+}
+
+// Filtered student report. On a bad expression returns false and out holds
+// the error message instead of the table.
+bool backend_filterStudents(const string& expr, string& out) {
+    TraceScope trace(TR_FILTER_STUDENTS, expr);
+    CompiledFilter<Student> f;
+    if (!filter_compile(expr, f, out))
+        return false;
+    vector<const Student*> rows = filter_run(f, gStudents);
+    out = format_studentTable(rows.size(),
+                              [&](size_t i) -> const Student& { return *rows[i]; },
+                              "(No matching students)\r\n");
+    return true;
+}
+
+bool backend_filterQueries(const string& expr, string& out) {
+    TraceScope trace(TR_FILTER_QUERIES, expr);
+    CompiledFilter<Query> f;
+    if (!filter_compile(expr, f, out))
+        return false;
+    vector<const Query*> rows = filter_run(f, gQueries);
+    out = format_queryTable(rows.size(),
+                            [&](size_t i) -> const Query& { return *rows[i]; },
+                            "(No matching queries)\r\n");
+    return true;
+}
+
+// ======================== REPLICATION (LOG SHIPPING) ========================
+// A leader process (started with --leader <dir>) writes every mutation to an
+// ordered log in <dir>. Any number of follower processes (--follower <dir>)
+// tail that log into their own in-memory copy and serve read-only lookups.
+// Only plain files are shared, so all processes just need the same directory.
+//
+//   srms.snap     full state at some LSN (written on open and every checkpoint)
+//   srms.<N>.log  frames with LSN >= N, appended and flushed per mutation
+//
+// A frame is [u32 len][varint lsn][varint leader ms][u8 op][payload]. Payloads
+// are schema_encode'd records, so applying a frame is an upsert. After a
+// checkpoint at LSN L the leader starts srms.<L+1>.log and drops older
+// segments. A follower whose next segment is gone reloads the snapshot.
+// Every file carries the leader's epoch (its start time), so followers start
+// over from the snapshot when the leader restarts.
+
+enum ReplOp : uint8_t {
+    REPL_PUT_STUDENT = 1,
+    REPL_DEL_STUDENT = 2,
+    REPL_PUT_QUERY   = 3,
+    REPL_HISTORY     = 4,
+    REPL_HEARTBEAT   = 5,   // no-op, lets followers measure lag while idle
+    REPL_ARCHIVE     = 6    // an archive run: new blocks + the keys moved into them
+};
+
+const size_t   REPL_CHECKPOINT_EVERY = 100000;   // frames per log segment
+const uint64_t REPL_HEARTBEAT_MS     = 1000;
+const size_t   REPL_HEADER_SIZE      = 24;       // magic + epoch + lsn/base
+static const char REPL_SNAP_MAGIC[] = "SRMSSNP1";
+static const char REPL_LOG_MAGIC[]  = "SRMSLOG1";
+
+string repl_snapPath(const string& dir) { return dir + "/srms.snap"; }
+string repl_logPath(const string& dir, uint64_t base) {
+    return dir + "/srms." + std::to_string(base) + ".log";
+}
+
+// magic + epoch + lsn (snapshot) or base LSN (log segment)
+string repl_header(const char* magic, uint64_t epoch, uint64_t lsn) {
+    string h(magic, 8);
+    put_u64(h, epoch);
+    put_u64(h, lsn);
+    return h;
+}
+
+bool repl_parseHeader(const char* magic, const char* p, size_t n, uint64_t& epoch, uint64_t& lsn) {
+    const char* end = p + n;
+    if (n < REPL_HEADER_SIZE || std::memcmp(p, magic, 8) != 0) return false;
+    p += 8;
+    return get_u64(p, end, epoch) && get_u64(p, end, lsn);
+}
+
+bool read_file(const string& path, string& out, size_t maxBytes = (size_t)-1) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    out.clear();
+    char buf[65536];
+    size_t n;
+    while (out.size() < maxBytes &&
+           (n = std::fread(buf, 1, std::min(sizeof buf, maxBytes - out.size()), f)) > 0)
+        out.append(buf, n);
+    std::fclose(f);
+    return true;
+}
+
+// ---- full-state snapshot ----
+
+void repl_encodeResult(string& out, const SemesterResult& r) {
+    value_encode(out, r.sem);
+    value_encode(out, r.sgpa);
+    value_encode(out, r.credits);
+    value_encode(out, r.grade);
+}
+
+void repl_encodeState(string& out) {
+    put_varint(out, gStudents.size());
+    for (const auto& s : gStudents) schema_encode(out, s);
+    put_varint(out, gQueries.size());
+    for (const auto& q : gQueries) schema_encode(out, q);
+    put_varint(out, (uint64_t)gNextQueryId);
+
+    put_varint(out, gHistory.size());
+    for (const auto& kv : gHistory) {
+        vector<SemesterResult> hist = history_decode(kv.second);
+        value_encode(out, kv.first);
+        put_varint(out, hist.size());
+        for (const auto& r : hist) repl_encodeResult(out, r);
+    }
+    archive_encodeIndex(out);
+}
+
+bool repl_decodeResult(const char*& p, const char* end, SemesterResult& r) {
+    return value_decode(p, end, r.sem) && value_decode(p, end, r.sgpa) &&
+           value_decode(p, end, r.credits) && value_decode(p, end, r.grade);
+}
+
+// replaces the whole in-memory store
+bool repl_decodeState(const char* p, const char* end) {
+    gStudents.clear();
+    gRollIndex.clear();
+    gQueries.clear();
+    gHistory.clear();
+
+    uint64_t n, next;
+    if (!get_varint(p, end, n)) return false;
+    gStudents.resize((size_t)n);
+    for (auto& s : gStudents)
+        if (!schema_decode(p, end, s)) return false;
+    students_reindex();
+    if (!get_varint(p, end, n)) return false;
+    gQueries.resize((size_t)n);
+    for (auto& q : gQueries)
+        if (!schema_decode(p, end, q)) return false;
+    if (!get_varint(p, end, next)) return false;
+    gNextQueryId = (int)next;
+
+    if (!get_varint(p, end, n)) return false;
+    for (uint64_t i = 0; i < n; ++i) {
+        int roll;
+        uint64_t count;
+        if (!value_decode(p, end, roll) || !get_varint(p, end, count)) return false;
+        HistoryColumns& h = gHistory[roll];
+        for (uint64_t k = 0; k < count; ++k) {
+            SemesterResult r;
+            if (!repl_decodeResult(p, end, r)) return false;
+            history_append(h, r);
+        }
+    }
+    return archive_decodeIndex(p, end);
+}
+
+// ---- applying frames (follower side) ----
+
+bool repl_apply(uint8_t op, const char* p, const char* end) {
+    switch (op) {
+    case REPL_PUT_STUDENT: {
+        Student s;
+        if (!schema_decode(p, end, s)) return false;
+        if (Student* x = findStudent(s.roll)) {
+            *x = s;
+        } else {
+            archive_forgetStudent(s.roll);       // restored from the archive
+            students_insert(s);
+        }
+        return true;
+    }
+    case REPL_DEL_STUDENT: {
+        int roll;
+        if (!value_decode(p, end, roll)) return false;
+        students_erase(roll);
+        gHistory.erase(roll);
+        archive_forgetStudent(roll);
+        return true;
+    }
+    case REPL_PUT_QUERY: {
+        Query q;
+        if (!schema_decode(p, end, q)) return false;
+        // gQueries stays in id order: new ids append, the rest are updates
+        if (q.id >= gNextQueryId) {
+            gNextQueryId = q.id + 1;
+            gQueries.push_back(q);
+        } else if (Query* x = findQuery(q.id)) {
+            *x = q;
+        } else {
+            gQueries.insert(std::lower_bound(gQueries.begin(), gQueries.end(), q.id,
+                                             [](const Query& a, int v) { return a.id < v; }), q);
+        }
+        return true;
+    }
+    case REPL_HISTORY: {
+        int roll;
+        SemesterResult r;
+        if (!value_decode(p, end, roll) || !repl_decodeResult(p, end, r)) return false;
+        history_append(gHistory[roll], r);
+        return true;
+    }
+    case REPL_ARCHIVE:
+        return archive_applyRun(p, end);
+    case REPL_HEARTBEAT:
+        return true;
+    }
+    return false;
+}
+
+// ---- leader ----
+
+struct ReplLeader {
+    string   dir;
+    FILE*    log           = nullptr;   // null = not a leader, hooks are no-ops
+    uint64_t epoch         = 0;
+    uint64_t lsn           = 0;         // last LSN written
+    uint64_t segmentBase   = 0;
+    size_t   segmentFrames = 0;
+    uint64_t lastWriteMs   = 0;
+    vector<uint64_t> segments;          // bases of the segments on disk, oldest first
+};
+
+static ReplLeader gLeader;
+
+bool write_file(const string& path, const string& data) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(data.data(), 1, data.size(), f) == data.size();
+    return (std::fclose(f) == 0) && ok;
+}
+
+// A running leader reports a failed checkpoint through the notifications
+// (console output, GUI message box); logging carries on regardless.
+bool repl_checkpointFailed(const string& why) {
+    if (gLeader.log)
+        gNotifications.push_back("Replication checkpoint failed: " + why +
+                                 ". Changes are still logged to " +
+                                 repl_logPath(gLeader.dir, gLeader.segmentBase) + ".");
+    return false;
+}
+
+// Snapshot at the current LSN, then start a fresh segment and drop the old
+// ones. The snapshot is written aside and the new segment created before
+// anything is switched, so a failure leaves the leader appending to its
+// current segment. Old segments are removed only once the new snapshot
+// covers them.
+bool replication_checkpoint() {
+    ReplLeader& L = gLeader;
+    const uint64_t base = L.lsn + 1;
+    if (L.log && base == L.segmentBase) return true;     // nothing logged since the last one
+
+    string snap = repl_header(REPL_SNAP_MAGIC, L.epoch, L.lsn);
+    repl_encodeState(snap);
+    string snapPath = repl_snapPath(L.dir);
+    string tmpPath  = snapPath + ".tmp";
+    if (!write_file(tmpPath, snap))
+        return repl_checkpointFailed("cannot write " + tmpPath);
+
+    string logPath = repl_logPath(L.dir, base);
+    string hdr     = repl_header(REPL_LOG_MAGIC, L.epoch, base);
+    FILE*  log     = std::fopen(logPath.c_str(), "wb");
+    if (!log || std::fwrite(hdr.data(), 1, hdr.size(), log) != hdr.size() || std::fflush(log) != 0) {
+        if (log) {
+            std::fclose(log);
+            std::remove(logPath.c_str());
+        }
+        std::remove(tmpPath.c_str());
+        return repl_checkpointFailed("cannot create " + logPath);
+    }
+
+    // the new segment is live from here: followers move on to it once they
+    // finish the old one, which stays until a snapshot covers it
+    if (L.log) std::fclose(L.log);
+    L.log           = log;
+    L.segmentBase   = base;
+    L.segmentFrames = 0;
+    L.lastWriteMs   = now_ms();
+    L.segments.push_back(base);
+
+    if (std::rename(tmpPath.c_str(), snapPath.c_str()) != 0) {
+        std::remove(snapPath.c_str());          // rename() won't replace on Windows
+        if (std::rename(tmpPath.c_str(), snapPath.c_str()) != 0)
+            return repl_checkpointFailed("cannot replace " + snapPath + "; older segments are kept");
+    }
+    // followers still reading them keep their handles; later ones use the snapshot
+    for (uint64_t b : L.segments)
+        if (b != base) std::remove(repl_logPath(L.dir, b).c_str());
+    L.segments.assign(1, base);
+    return true;
+}
+
+// Makes this process the leader for dir, publishing the current state.
+bool replication_openLeader(const string& dir) {
+    gLeader.dir   = dir;
+    gLeader.epoch = now_ms();
+    gLeader.lsn   = 0;
+    return replication_checkpoint();
+}
+
+void repl_append(uint8_t op, const string& payload) {
+    ReplLeader& L = gLeader;
+    string body;
+    put_varint(body, ++L.lsn);
+    L.lastWriteMs = now_ms();
+    put_varint(body, L.lastWriteMs);
+    body.push_back((char)op);
+    body.append(payload);
+
+    string frame;
+    put_u32(frame, (uint32_t)body.size());
+    frame.append(body);
+    std::fwrite(frame.data(), 1, frame.size(), L.log);
+    std::fflush(L.log);
+
+    // a failed checkpoint is retried after another segment's worth of frames
+    if (++L.segmentFrames >= REPL_CHECKPOINT_EVERY && !replication_checkpoint())
+        L.segmentFrames = 0;
+}
+
+void repl_logStudent(const Student& s) {
+    if (!gLeader.log) return;
+    string p;
+    schema_encode(p, s);
+    repl_append(REPL_PUT_STUDENT, p);
+}
+
+void repl_logDeleteStudent(int roll) {
+    if (!gLeader.log) return;
+    string p;
+    value_encode(p, roll);
+    repl_append(REPL_DEL_STUDENT, p);
+}
+
+void repl_logQuery(const Query& q) {
+    if (!gLeader.log) return;
+    string p;
+    schema_encode(p, q);
+    repl_append(REPL_PUT_QUERY, p);
+}
+
+// payload built by the archive (archive_encodeRun)
+void repl_logArchive(const string& payload) {
+    if (!gLeader.log) return;
+    repl_append(REPL_ARCHIVE, payload);
+}
+
+void repl_logHistory(int roll, const SemesterResult& r) {
+    if (!gLeader.log) return;
+    string p;
+    value_encode(p, roll);
+    repl_encodeResult(p, r);
+    repl_append(REPL_HISTORY, p);
+}
+
+void replication_heartbeat() {
+    if (gLeader.log && now_ms() - gLeader.lastWriteMs >= REPL_HEARTBEAT_MS)
+        repl_append(REPL_HEARTBEAT, string());
+}
+
+// ---- follower ----
+
+struct ReplFollower {
+    string   dir;
+    FILE*    log          = nullptr;   // current segment
+    uint64_t segmentBase  = 0;
+    long     offset       = 0;         // next unread byte in the segment
+    uint64_t epoch        = 0;         // 0 = nothing loaded yet
+    uint64_t applied      = 0;         // last applied LSN
+    uint64_t lastLeaderMs = 0;         // leader clock of the last applied frame
+    uint64_t snapshotLoads = 0;
+};
+
+static ReplFollower gFollower;
+
+void repl_closeSegment(ReplFollower& f) {
+    if (f.log) std::fclose(f.log);
+    f.log = nullptr;
+}
+
+bool repl_openSegment(ReplFollower& f, uint64_t base) {
+    FILE* log = std::fopen(repl_logPath(f.dir, base).c_str(), "rb");
+    if (!log) return false;
+    char hdr[REPL_HEADER_SIZE];
+    uint64_t epoch, b;
+    if (std::fread(hdr, 1, sizeof hdr, log) != sizeof hdr ||
+        !repl_parseHeader(REPL_LOG_MAGIC, hdr, sizeof hdr, epoch, b) ||
+        epoch != f.epoch || b != base) {
+        std::fclose(log);
+        return false;
+    }
+    repl_closeSegment(f);
+    f.log         = log;
+    f.segmentBase = base;
+    f.offset      = (long)REPL_HEADER_SIZE;
+    return true;
+}
+
+bool repl_loadSnapshot(ReplFollower& f) {
+    string snap;
+    uint64_t epoch, lsn;
+    if (!read_file(repl_snapPath(f.dir), snap) ||
+        !repl_parseHeader(REPL_SNAP_MAGIC, snap.data(), snap.size(), epoch, lsn) ||
+        !repl_decodeState(snap.data() + REPL_HEADER_SIZE, snap.data() + snap.size()))
+        return false;
+    repl_closeSegment(f);
+    f.epoch   = epoch;
+    f.applied = lsn;
+    ++f.snapshotLoads;
+    return true;
+}
+
+// Reads complete frames from the current segment; false on a gap or a
+// corrupt frame (caller falls back to the snapshot).
+bool repl_readFrames(ReplFollower& f) {
+    std::fseek(f.log, 0, SEEK_END);
+    long size = std::ftell(f.log);
+    std::fseek(f.log, f.offset, SEEK_SET);
+
+    string body;
+    while (size - f.offset >= 4) {
+        char lenBuf[4];
+        uint32_t len;
+        const char* lp = lenBuf;
+        if (std::fread(lenBuf, 1, 4, f.log) != 4 || !get_u32(lp, lenBuf + 4, len))
+            return false;
+        if ((uint64_t)(size - f.offset - 4) < len) break;   // frame still being written
+
+        body.resize(len);
+        if (len && std::fread(&body[0], 1, len, f.log) != len) return false;
+        const char* p   = body.data();
+        const char* end = p + body.size();
+        uint64_t lsn, ms;
+        if (!get_varint(p, end, lsn) || !get_varint(p, end, ms) || p >= end) return false;
+        uint8_t op = (uint8_t)*p++;
+
+        if (lsn > f.applied + 1) return false;
+        if (lsn == f.applied + 1) {
+            if (!repl_apply(op, p, end)) return false;
+            f.applied      = lsn;
+            f.lastLeaderMs = ms;
+        }
+        f.offset += 4 + (long)len;
+    }
+    std::fseek(f.log, f.offset, SEEK_SET);
+    return true;
+}
+
+// Brings this follower up to date with whatever the leader has flushed.
+void replication_poll() {
+    ReplFollower& f = gFollower;
+
+    // (re)start from the snapshot on first use or after a leader restart
+    string hdr;
+    uint64_t epoch, snapLsn;
+    if (!read_file(repl_snapPath(f.dir), hdr, REPL_HEADER_SIZE) ||
+        !repl_parseHeader(REPL_SNAP_MAGIC, hdr.data(), hdr.size(), epoch, snapLsn))
+        return;
+    if (epoch != f.epoch && !repl_loadSnapshot(f))
+        return;
+
+    for (int guard = 0; guard < 1000; ++guard) {
+        if (f.log && !repl_readFrames(f)) {
+            repl_loadSnapshot(f);
+            return;
+        }
+        if (f.log && f.segmentBase == f.applied + 1)
+            return;                                 // live segment, nothing new yet
+        // the segment is done once the leader has started the next one
+        if (repl_openSegment(f, f.applied + 1))
+            continue;
+        // next segment already dropped by a checkpoint: catch up from the snapshot
+        if (snapLsn > f.applied && repl_loadSnapshot(f))
+            continue;
+        return;
+    }
+}
+
+string replication_status() {
+    const ReplFollower& f = gFollower;
+    if (f.epoch == 0)
+        return "Replication: no leader snapshot found in " + f.dir;
+    string s = "Replication: applied LSN " + std::to_string(f.applied);
+    if (f.lastLeaderMs)
+        s += ", lag " + std::to_string(now_ms() - f.lastLeaderMs) + " ms";
+    else
+        s += ", lag unknown (no frames since snapshot)";
+    s += " (leader heartbeat every " + std::to_string(REPL_HEARTBEAT_MS) + " ms)";
+    s += ", snapshot loads " + std::to_string(f.snapshotLoads);
+    return s;
+}
+
+// ======================== COLD ARCHIVE ========================
+// Moves two kinds of record out of RAM:
+// - queries resolved more than ARCHIVE_RESOLVED_AGE ago
+// - graduated students, with their history: the GRADUATION_SEM result is
+//   on record, the record has not been written for ARCHIVE_GRADUATE_IDLE
+//   and no query of theirs is open
+// They go to an append-only file of LZ-compressed blocks (~32 KB raw each).
+// Only a block directory (16 bytes/block) and sorted (key, block) pairs
+// (8 bytes per archived record, plus 8 per student for a hash of the name)
+// stay resident, so the hot set stays small
+// as years of history accumulate. backend_getStudentByRoll,
+// backend_getQueryById and search-by-name fall back to the archive. The
+// last decompressed block is cached. A write to an archived student
+// (update, semester result, new query) first restores them, with their
+// history, to the hot store; deleting one drops their key. Either way the
+// stale copy stays in its block, unreachable, and an archived roll cannot be
+// added again. The in-memory store is not persisted,
+// so the archive file is recreated on each run.
+// A run only drops hot records once the blocks holding them are written and
+// flushed; if the file cannot be written, the records stay in memory.
+// Followers read the same file. A leader keeps it in its replication dir
+// and a follower opens it there (<dir>/srms.archive, resolved against its own
+// --follower dir; --archive names it when the leader's is elsewhere). Each
+// run is replicated as one REPL_ARCHIVE frame carrying the new block
+// directory entries and keys, and snapshots carry the whole index, so the
+// same lookups fall back to the archive on every replica.
+
+// ---- LZ77 block codec ----
+// Sequences of [varint literal count][literals][varint match len - 4][varint distance];
+// the last sequence has literals only. Matches are found through a hash of
+// the next 4 bytes, so repeated depts, names, statuses and message text
+// across the records of a block compress away.
+
+const size_t LZ_MIN_MATCH = 4;
+const int    LZ_HASH_BITS = 13;
+
+string lz_compress(const string& in) {
+    string out;
+    out.reserve(in.size() / 2 + 16);
+    vector<int> table((size_t)1 << LZ_HASH_BITS, -1);
+    const unsigned char* s = (const unsigned char*)in.data();
+    const size_t n = in.size();
+
+    size_t anchor = 0, i = 0;
+    while (i + LZ_MIN_MATCH <= n) {
+        uint32_t v;
+        std::memcpy(&v, s + i, 4);
+        uint32_t h = (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+        int cand = table[h];
+        table[h] = (int)i;
+        if (cand < 0 || std::memcmp(s + cand, s + i, LZ_MIN_MATCH) != 0) {
+            ++i;
+            continue;
+        }
+        size_t len = LZ_MIN_MATCH;
+        while (i + len < n && s[cand + len] == s[i + len]) ++len;
+
+        put_varint(out, i - anchor);
+        out.append(in, anchor, i - anchor);
+        put_varint(out, len - LZ_MIN_MATCH);
+        put_varint(out, i - (size_t)cand);
+        i += len;
+        anchor = i;
+    }
+    put_varint(out, n - anchor);
+    out.append(in, anchor, n - anchor);
+    return out;
+}
+
+bool lz_decompress(const char* p, const char* end, size_t rawLen, string& out) {
+    out.clear();
+    out.reserve(rawLen);
+    for (;;) {
+        uint64_t lit, len, dist;
+        if (!get_varint(p, end, lit) || (uint64_t)(end - p) < lit) return false;
+        out.append(p, (size_t)lit);
+        p += lit;
+        if (p == end) return out.size() == rawLen;
+
+        if (!get_varint(p, end, len) || !get_varint(p, end, dist) ||
+            dist == 0 || dist > out.size() || out.size() + len + LZ_MIN_MATCH > rawLen)
+            return false;
+        size_t from = out.size() - (size_t)dist;
+        for (uint64_t k = 0; k < len + LZ_MIN_MATCH; ++k)
+            out.push_back(out[from + k]);            // may overlap: byte by byte
+    }
+}
+
+// ---- archive file ----
+
+const size_t    ARCHIVE_BLOCK_BYTES  = 32 * 1024;
+const long long ARCHIVE_RESOLVED_AGE = 30LL * 24 * 60 * 60;
+const long long ARCHIVE_GRADUATE_IDLE = 180LL * 24 * 60 * 60;
+const long long ARCHIVE_INTERVAL     = 60 * 60;   // backend_tick runs it hourly
+const int       GRADUATION_SEM       = 8;
+
+enum ArchiveKind : char { ARCH_STUDENT = 'S', ARCH_QUERY = 'Q' };
+
+struct ArchiveBlock {
+    uint64_t offset;
+    uint32_t compLen;
+    uint32_t rawLen;
+};
+
+struct ArchiveKey {
+    int      key;       // roll or query id
+    uint32_t block;
+    bool operator<(const ArchiveKey& o) const { return key < o.key; }
+};
+
+struct ColdArchive {
+    string               path = "srms_archive.dat";
+    FILE*                file = nullptr;
+    vector<ArchiveBlock> blocks;
+    vector<ArchiveKey>   students, queries;     // sorted by key
+    vector<ArchiveKey>   names;                 // (name hash, block), sorted by hash
+    string               pending;               // records of the unsealed block
+    vector<ArchiveKey>   pendingStudents, pendingQueries, pendingNames;
+    long long            lastRun = 0;
+    bool                 writeFailed = false;   // last run could not write
+
+    uint32_t cachedBlock = UINT32_MAX;          // last block read back
+    string   cachedRaw;
+};
+
+static ColdArchive gArchive;
+
+bool archive_setPath(const string& path) {
+    if (gArchive.file) return false;     // too late once records were moved
+    gArchive.path = path;
+    return true;
+}
+
+// forgets the current archive (follower loading a new snapshot); the path stays
+void archive_reset() {
+    ColdArchive& A = gArchive;
+    if (A.file) std::fclose(A.file);
+    A.file = nullptr;
+    A.blocks.clear();
+    A.students.clear();
+    A.queries.clear();
+    A.names.clear();
+    A.pending.clear();
+    A.pendingStudents.clear();
+    A.pendingQueries.clear();
+    A.pendingNames.clear();
+    A.cachedBlock = UINT32_MAX;
+}
 
-void backend_init() {
-    // currently nothing
+// What one archive run committed: the blocks it wrote and the keys in them.
+struct ArchiveRun {
+    uint32_t           firstBlock = 0;
+    vector<ArchiveKey> students, queries, names;
+};
+
+void archive_mergeKeys(vector<ArchiveKey>& index, const vector<ArchiveKey>& added) {
+    size_t mid = index.size();
+    index.insert(index.end(), added.begin(), added.end());
+    std::sort(index.begin() + (std::ptrdiff_t)mid, index.end());
+    std::inplace_merge(index.begin(), index.begin() + (std::ptrdiff_t)mid, index.end());
 }
 
-bool backend_addStudent(int roll,
-                        const string& name,
-                        const string& dept,
-                        int sem,
-                        float cgpa,
-                        char grade) {
-    if (roll <= 0 || name.empty() || dept.empty())
+// Writes and flushes the pending block. Only then are its keys indexed and
+// added to run; on failure everything stays pending.
+bool archive_seal(ArchiveRun& run) {
+    ColdArchive& A = gArchive;
+    if (A.pending.empty()) return true;
+    if (!A.file && !(A.file = std::fopen(A.path.c_str(), "w+b")))
         return false;
 
-    Student s;
-    s.roll  = roll;
-    s.name  = name;
-    s.dept  = dept;
-    s.sem   = sem;
-    s.cgpa  = cgpa;
-    s.grade = grade;
+    string comp = lz_compress(A.pending);
+    if (std::fseek(A.file, 0, SEEK_END) != 0) return false;
+    long offset = std::ftell(A.file);
+    if (offset < 0 ||
+        std::fwrite(comp.data(), 1, comp.size(), A.file) != comp.size() ||
+        std::fflush(A.file) != 0)
+        return false;
 
-    gStudents.push_back(s);
+    A.blocks.push_back(ArchiveBlock{(uint64_t)offset, (uint32_t)comp.size(), (uint32_t)A.pending.size()});
+    archive_mergeKeys(A.students, A.pendingStudents);
+    archive_mergeKeys(A.queries,  A.pendingQueries);
+    archive_mergeKeys(A.names,    A.pendingNames);
+    run.students.insert(run.students.end(), A.pendingStudents.begin(), A.pendingStudents.end());
+    run.queries.insert(run.queries.end(), A.pendingQueries.begin(), A.pendingQueries.end());
+    run.names.insert(run.names.end(), A.pendingNames.begin(), A.pendingNames.end());
+    A.pendingStudents.clear();
+    A.pendingQueries.clear();
+    A.pendingNames.clear();
+    A.pending.clear();
+    A.pending.shrink_to_fit();
     return true;
 }
 
-// update student (admin can correct details after checking queries)
-bool backend_updateStudent(int roll,
-                           const string& name,
-                           const string& dept,
-                           int sem,
-                           float cgpa,
-                           char grade) {
-    for (auto &s : gStudents) {
-        if (s.roll == roll) {
-            s.name  = name;
-            s.dept  = dept;
-            s.sem   = sem;
-            s.cgpa  = cgpa;
-            s.grade = grade;
-            return true;
+void archive_discardPending() {
+    ColdArchive& A = gArchive;
+    A.pending.clear();
+    A.pendingStudents.clear();
+    A.pendingQueries.clear();
+    A.pendingNames.clear();
+}
+
+// FNV-1a; search-by-name matches names exactly
+int archive_nameHash(const string& name) {
+    uint32_t h = 2166136261u;
+    for (unsigned char c : name) h = (h ^ c) * 16777619u;
+    return (int)h;
+}
+
+void archive_putStudent(const Student& s, const vector<SemesterResult>& hist) {
+    ColdArchive& A = gArchive;
+    A.pendingStudents.push_back(ArchiveKey{s.roll, (uint32_t)A.blocks.size()});
+    A.pendingNames.push_back(ArchiveKey{archive_nameHash(s.name), (uint32_t)A.blocks.size()});
+    A.pending.push_back(ARCH_STUDENT);
+    schema_encode(A.pending, s);
+    put_varint(A.pending, hist.size());
+    for (const auto& r : hist) repl_encodeResult(A.pending, r);
+}
+
+void archive_putQuery(const Query& q) {
+    ColdArchive& A = gArchive;
+    A.pendingQueries.push_back(ArchiveKey{q.id, (uint32_t)A.blocks.size()});
+    A.pending.push_back(ARCH_QUERY);
+    schema_encode(A.pending, q);
+}
+
+const string* archive_readBlock(uint32_t b) {
+    ColdArchive& A = gArchive;
+    if (b == A.cachedBlock) return &A.cachedRaw;
+    if (b >= A.blocks.size()) return nullptr;
+    // a leader opened it for writing; a follower reads the leader's file
+    if (!A.file && !(A.file = std::fopen(A.path.c_str(), "rb"))) return nullptr;
+
+    const ArchiveBlock& blk = A.blocks[b];
+    string comp(blk.compLen, '\0');
+    std::fseek(A.file, (long)blk.offset, SEEK_SET);
+    if (std::fread(&comp[0], 1, comp.size(), A.file) != comp.size() ||
+        !lz_decompress(comp.data(), comp.data() + comp.size(), blk.rawLen, A.cachedRaw)) {
+        A.cachedBlock = UINT32_MAX;
+        return nullptr;
+    }
+    A.cachedBlock = b;
+    return &A.cachedRaw;
+}
+
+// Calls fn(kind, student, history, query) for each record of block b until
+// fn returns true; returns whether it did.
+template <typename Fn>
+bool archive_scanBlock(uint32_t b, Fn fn) {
+    const string* raw = archive_readBlock(b);
+    if (!raw) return false;
+    const char* p   = raw->data();
+    const char* end = p + raw->size();
+
+    Student s;
+    Query   q;
+    vector<SemesterResult> hist;
+    while (p < end) {
+        char kind = *p++;
+        if (kind == ARCH_STUDENT) {
+            uint64_t n;
+            if (!schema_decode(p, end, s) || !get_varint(p, end, n)) return false;
+            hist.resize((size_t)n);
+            for (auto& r : hist)
+                if (!repl_decodeResult(p, end, r)) return false;
+        } else if (kind != ARCH_QUERY || !schema_decode(p, end, q)) {
+            return false;
         }
+        if (fn(kind, s, hist, q)) return true;
     }
-    return false;  // not found
+    return false;
 }
 
-// delete student by roll
-bool backend_deleteStudent(int roll) {
-    for (auto it = gStudents.begin(); it != gStudents.end(); ++it) {
-        if (it->roll == roll) {
-            gStudents.erase(it);
+const ArchiveKey* archive_find(const vector<ArchiveKey>& index, int key) {
+    auto it = std::lower_bound(index.begin(), index.end(), ArchiveKey{key, 0});
+    return (it != index.end() && it->key == key) ? &*it : nullptr;
+}
+
+bool archive_findStudent(int roll, Student& out, vector<SemesterResult>& hist) {
+    const ArchiveKey* k = archive_find(gArchive.students, roll);
+    return k && archive_scanBlock(k->block,
+        [&](char kind, const Student& s, const vector<SemesterResult>& h, const Query&) {
+            if (kind != ARCH_STUDENT || s.roll != roll) return false;
+            out  = s;
+            hist = h;
             return true;
-        }
+        });
+}
+
+bool archive_findQuery(int id, Query& out) {
+    const ArchiveKey* k = archive_find(gArchive.queries, id);
+    return k && archive_scanBlock(k->block,
+        [&](char kind, const Student&, const vector<SemesterResult>&, const Query& q) {
+            if (kind != ARCH_QUERY || q.id != id) return false;
+            out = q;
+            return true;
+        });
+}
+
+// Reads only the blocks whose students include the name's hash, so a miss
+// usually reads none. Name keys are not dropped when a student leaves the
+// archive, so a copy only counts if the roll index still points at its block.
+bool archive_findStudentByName(const string& name, int& roll) {
+    const vector<ArchiveKey>& names = gArchive.names;
+    auto range = std::equal_range(names.begin(), names.end(), ArchiveKey{archive_nameHash(name), 0});
+    for (auto it = range.first; it != range.second; ++it) {
+        const uint32_t b = it->block;
+        bool hit = archive_scanBlock(b,
+            [&](char kind, const Student& s, const vector<SemesterResult>&, const Query&) {
+                if (kind != ARCH_STUDENT || s.name != name) return false;
+                const ArchiveKey* k = archive_find(gArchive.students, s.roll);
+                if (!k || k->block != b) return false;     // restored or deleted since
+                roll = s.roll;
+                return true;
+            });
+        if (hit) return true;
     }
     return false;
 }
 
-int backend_addStudentNameOnly(const string& name) {
-    int newRoll = (gStudents.empty() ? 1 : gStudents.back().roll + 1);
+bool archive_hasStudent(int roll) {
+    return archive_find(gArchive.students, roll) != nullptr;
+}
 
+void archive_forgetStudent(int roll) {
+    vector<ArchiveKey>& keys = gArchive.students;
+    auto it = std::lower_bound(keys.begin(), keys.end(), ArchiveKey{roll, 0});
+    if (it != keys.end() && it->key == roll) keys.erase(it);
+}
+
+// Moves an archived student back to the hot store. Followers get it as a
+// fresh put plus its history.
+Student* archive_restoreStudent(int roll) {
     Student s;
-    s.roll  = newRoll;
-    s.name  = name;
-    s.dept  = "N/A";
-    s.sem   = 0;
-    s.cgpa  = 0.0f;
-    s.grade = '-';
+    vector<SemesterResult> hist;
+    if (!archive_findStudent(roll, s, hist)) return nullptr;
+    archive_forgetStudent(roll);
+    s.updatedAt = now_s();
+    students_insert(s);
+    repl_logStudent(s);
+    for (const auto& r : hist) {
+        history_append(gHistory[roll], r);
+        repl_logHistory(roll, r);
+    }
+    return findStudent(roll);
+}
 
-    gStudents.push_back(s);
-    return newRoll;
+// completed the final semester, untouched since, nothing open
+bool archive_graduated(const Student& s, long long now) {
+    auto h = gHistory.find(s.roll);
+    return h != gHistory.end() && !h->second.grades.empty() &&
+           h->second.lastSem >= GRADUATION_SEM &&
+           now - s.updatedAt >= ARCHIVE_GRADUATE_IDLE && !gOpenByRoll.count(s.roll);
 }
 
-int backend_searchNameOrAdd(const string& name, bool &wasAdded) {
-    wasAdded = false;
-    for (const auto& s : gStudents) {
-        if (s.name == name) {
-            return s.roll;     // existing student
-        }
+// sorted copy of the keys, for binary_search
+vector<int> archive_keyList(const vector<ArchiveKey>& keys) {
+    vector<int> out;
+    out.reserve(keys.size());
+    for (const auto& k : keys) out.push_back(k.key);
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+// Drops what a run committed from the hot store, one pass per vector.
+void store_dropArchived(const ArchiveRun& run) {
+    if (!run.queries.empty()) {
+        const vector<int> ids = archive_keyList(run.queries);
+        gQueries.erase(std::remove_if(gQueries.begin(), gQueries.end(), [&](const Query& q) {
+            return std::binary_search(ids.begin(), ids.end(), q.id);
+        }), gQueries.end());
+        gQueries.shrink_to_fit();
+    }
+    if (!run.students.empty()) {
+        const vector<int> rolls = archive_keyList(run.students);
+        gStudents.erase(std::remove_if(gStudents.begin(), gStudents.end(), [&](const Student& s) {
+            return std::binary_search(rolls.begin(), rolls.end(), s.roll);
+        }), gStudents.end());
+        gStudents.shrink_to_fit();
+        students_reindex();
+        for (int roll : rolls) gHistory.erase(roll);
     }
-    wasAdded = true;
-    return backend_addStudentNameOnly(name);
 }
 
-string backend_getStudentByRoll(int roll) {
+// ---- replication ----
+// A run is encoded as
+//   [varint first block][varint n]{[u64 offset][u32 comp len][u32 raw len]} x n
+//   [varint n]{[i32 roll][varint block]} x n   [varint n]{[i32 id][varint block]} x n
+//   [varint n]{[i32 name hash][varint block]} x n
+// with the block entries from the first block to the end of the directory.
+// A snapshot holds the whole index as one run from block 0. The file path is
+// not in it: each follower resolves that locally.
+
+void archive_encodeKeys(string& out, const vector<ArchiveKey>& keys) {
+    put_varint(out, keys.size());
+    for (const auto& k : keys) {
+        value_encode(out, k.key);
+        put_varint(out, k.block);
+    }
+}
+
+bool archive_decodeKeys(const char*& p, const char* end, vector<ArchiveKey>& keys) {
+    uint64_t n, block;
+    if (!get_varint(p, end, n) || n > (uint64_t)(end - p)) return false;
+    keys.resize((size_t)n);
+    for (auto& k : keys) {
+        if (!value_decode(p, end, k.key) || !get_varint(p, end, block)) return false;
+        k.block = (uint32_t)block;
+    }
+    return true;
+}
+
+void archive_encodeRun(string& out, uint32_t firstBlock, const vector<ArchiveKey>& students,
+                       const vector<ArchiveKey>& queries, const vector<ArchiveKey>& names) {
+    const vector<ArchiveBlock>& blocks = gArchive.blocks;
+    put_varint(out, firstBlock);
+    put_varint(out, blocks.size() - firstBlock);
+    for (size_t b = firstBlock; b < blocks.size(); ++b) {
+        put_u64(out, blocks[b].offset);
+        put_u32(out, blocks[b].compLen);
+        put_u32(out, blocks[b].rawLen);
+    }
+    archive_encodeKeys(out, students);
+    archive_encodeKeys(out, queries);
+    archive_encodeKeys(out, names);
+}
+
+bool archive_decodeRun(const char*& p, const char* end, ArchiveRun& run, vector<ArchiveBlock>& blocks) {
+    uint64_t first, n;
+    if (!get_varint(p, end, first) || !get_varint(p, end, n) || n > (uint64_t)(end - p) / 16)
+        return false;
+    run.firstBlock = (uint32_t)first;
+    blocks.resize((size_t)n);
+    for (auto& b : blocks)
+        if (!get_u64(p, end, b.offset) || !get_u32(p, end, b.compLen) || !get_u32(p, end, b.rawLen))
+            return false;
+    return archive_decodeKeys(p, end, run.students) && archive_decodeKeys(p, end, run.queries) &&
+           archive_decodeKeys(p, end, run.names);
+}
+
+void archive_encodeIndex(string& out) {
+    archive_encodeRun(out, 0, gArchive.students, gArchive.queries, gArchive.names);
+}
+
+bool archive_decodeIndex(const char*& p, const char* end) {
+    ArchiveRun run;
+    vector<ArchiveBlock> blocks;
+    if (!archive_decodeRun(p, end, run, blocks) || run.firstBlock != 0)
+        return false;
+    archive_reset();
+    gArchive.blocks   = std::move(blocks);
+    gArchive.students = std::move(run.students);     // already sorted
+    gArchive.queries  = std::move(run.queries);
+    gArchive.names    = std::move(run.names);
+    return true;
+}
+
+// Follower side of a leader's archive run: index its blocks and drop the
+// records it moved. The blocks are already in the leader's file.
+bool archive_applyRun(const char*& p, const char* end) {
+    ArchiveRun run;
+    vector<ArchiveBlock> blocks;
+    if (!archive_decodeRun(p, end, run, blocks) || run.firstBlock != gArchive.blocks.size())
+        return false;
+    gArchive.blocks.insert(gArchive.blocks.end(), blocks.begin(), blocks.end());
+    archive_mergeKeys(gArchive.students, run.students);
+    archive_mergeKeys(gArchive.queries,  run.queries);
+    archive_mergeKeys(gArchive.names,    run.names);
+    store_dropArchived(run);
+    return true;
+}
+
+// Moves cold records out of the hot store; returns how many were moved.
+// Records are written first; the hot copies go (and followers are told)
+// only for blocks that reached the file.
+size_t backend_archiveCold(long long now) {
+    ColdArchive& A = gArchive;
+    ArchiveRun run;
+    run.firstBlock = (uint32_t)A.blocks.size();
+
+    bool ok = true;
+    for (const auto& q : gQueries) {
+        if (!ok || q.status != "Resolved" || now - q.updatedAt < ARCHIVE_RESOLVED_AGE)
+            continue;
+        archive_putQuery(q);
+        if (A.pending.size() >= ARCHIVE_BLOCK_BYTES) ok = archive_seal(run);
+    }
     for (const auto& s : gStudents) {
-        if (s.roll == roll) {
-            ostringstream oss;
-            oss << "Roll   : " << s.roll  << "\r\n"
-                << "Name   : " << s.name  << "\r\n"
-                << "Dept   : " << s.dept  << "\r\n"
-                << "Sem    : " << s.sem   << "\r\n"
-                << "CGPA   : " << s.cgpa  << "\r\n"
-                << "Grade  : " << s.grade;
-            return oss.str();
+        if (!ok) break;
+        if (!archive_graduated(s, now)) continue;
+        archive_putStudent(s, backend_getHistory(s.roll));
+        if (A.pending.size() >= ARCHIVE_BLOCK_BYTES) ok = archive_seal(run);
+    }
+    if (ok) ok = archive_seal(run);
+    if (!ok) archive_discardPending();          // those records just stay hot
+    A.writeFailed = !ok;
+
+    store_dropArchived(run);
+    if (!run.students.empty() || !run.queries.empty()) {
+        string p;
+        archive_encodeRun(p, run.firstBlock, run.students, run.queries, run.names);
+        repl_logArchive(p);
+    }
+    return run.students.size() + run.queries.size();
+}
+
+string backend_archiveStats() {
+    const ColdArchive& A = gArchive;
+    uint64_t raw = 0, comp = 0;
+    for (const auto& b : A.blocks) { raw += b.rawLen; comp += b.compLen; }
+    return "Archive: " + std::to_string(A.students.size()) + " students, " +
+           std::to_string(A.queries.size()) + " queries in " +
+           std::to_string(A.blocks.size()) + " blocks, " + std::to_string(raw) +
+           " -> " + std::to_string(comp) + " bytes" +
+           (A.writeFailed ? "\nLast run could not write " + A.path + "; records kept in memory" : "");
+}
+
+void archive_maybeRun(long long now) {
+    if (gArchive.lastRun == 0) gArchive.lastRun = now;   // not right at startup
+    if (now - gArchive.lastRun < ARCHIVE_INTERVAL) return;
+    gArchive.lastRun = now;
+    backend_archiveCold(now);
+}
+
+// periodic housekeeping, called about once a second
+void backend_tick() {
+    long long now = now_s();
+    sla_advance(now);
+    archive_maybeRun(now);
+    replication_heartbeat();
+}
+
+// ======================== LOAD REPLAY ========================
+// srms_gui --replay <trace file | mix:L/U/Q> [--rate ops/s | --speed factor]
+//                   [--threads N] [--ops N] [--students N]
+// A trace file (from --trace) is replayed call for call. A mix generates
+// --ops calls over a pre-loaded roster of --students: L% lookups, U% updates
+// and Q% new queries (e.g. mix:90/5/5). Calls are spread over --threads
+// workers. Without a pace they run back to back. --rate issues them on a
+// fixed schedule. --speed (traces only) keeps the recorded arrival times,
+// bursts and idle gaps included, scaled by the factor (2 = twice as fast).
+// Paced runs are open loop: latency is measured from each call's scheduled
+// start, so queueing delay counts too. The store is single-writer, so
+// workers take gStoreMutex; extra threads measure contention, not parallel
+// speed-up.
+
+struct ReplayOp {
+    uint8_t  op;
+    string   args;        // value_encode'd, as in the trace
+    uint64_t atUs  = 0;   // recorded start, relative to the first call
+    uint64_t durNs = 0;   // recorded duration (0 for generated calls)
+};
+
+static std::mutex gStoreMutex;
+
+inline bool replay_args(const char*&, const char*) { return true; }
+
+template <typename T, typename... Rest>
+bool replay_args(const char*& p, const char* end, T& v, Rest&... rest) {
+    return value_decode(p, end, v) && replay_args(p, end, rest...);
+}
+
+template <typename... Rest>
+bool replay_args(const char*& p, const char* end, Student& s, Rest&... rest) {
+    return schema_decode(p, end, s) && replay_args(p, end, rest...);
+}
+
+// Re-issues one recorded call; false if its arguments don't decode.
+bool replay_execute(const ReplayOp& r) {
+    const char* p   = r.args.data();
+    const char* end = p + r.args.size();
+    int roll = 0, sem = 0, credits = 0, id = 0;
+    long long page = 0, size = 0;
+    float cgpa = 0.0f;
+    char grade = 0;
+    string name, text, out;
+    Student s{};
+    bool wasAdded;
+
+    switch (r.op) {
+    case TR_ADD_STUDENT:
+        if (!replay_args(p, end, s)) return false;
+        backend_addStudent(s);
+        return true;
+    case TR_UPDATE_STUDENT:
+        if (!replay_args(p, end, s)) return false;
+        backend_updateStudent(s);
+        return true;
+    case TR_DELETE_STUDENT:
+        if (!replay_args(p, end, roll)) return false;
+        backend_deleteStudent(roll);
+        return true;
+    case TR_SEARCH_NAME:
+        if (!replay_args(p, end, name)) return false;
+        backend_searchNameOrAdd(name, wasAdded);
+        return true;
+    case TR_GET_STUDENT:
+        if (!replay_args(p, end, roll)) return false;
+        backend_getStudentByRoll(roll);
+        return true;
+    case TR_LIST_STUDENTS:
+        backend_getAllStudents();
+        return true;
+    case TR_ADD_QUERY:
+        if (!replay_args(p, end, roll, name, text)) return false;
+        backend_addQuery(roll, name, text);
+        return true;
+    case TR_LIST_QUERIES:
+        backend_getAllQueries();
+        return true;
+    case TR_FILTER_STUDENTS:
+    case TR_FILTER_QUERIES:
+        if (!replay_args(p, end, text)) return false;
+        if (r.op == TR_FILTER_STUDENTS) backend_filterStudents(text, out);
+        else                            backend_filterQueries(text, out);
+        return true;
+    case TR_SEM_RESULT:
+        if (!replay_args(p, end, roll, sem, cgpa, credits, grade)) return false;
+        backend_addSemesterResult(roll, sem, cgpa, credits, grade);
+        return true;
+    case TR_RESOLVE_QUERY:
+        if (!replay_args(p, end, id)) return false;
+        backend_resolveQuery(id);
+        return true;
+    case TR_JOINED_QUERIES:
+        if (!replay_args(p, end, page, size)) return false;
+        backend_getJoinedQueries((size_t)page, (size_t)size);
+        return true;
+    case TR_FALLING_CGPA:
+        if (!replay_args(p, end, sem)) return false;
+        backend_getFallingCgpa(sem);
+        return true;
+    case TR_GET_QUERY:
+        if (!replay_args(p, end, id)) return false;
+        backend_getQueryById(id);
+        return true;
+    }
+    return false;
+}
+
+// Argument layout per TraceOp (i int, l long long, f float, c char, s string,
+// S Student record).
+static const char* const TRACE_ARG_TYPES[] = {
+    "",         // unused
+    "S",        // TR_ADD_STUDENT
+    "S",        // TR_UPDATE_STUDENT
+    "i",        // TR_DELETE_STUDENT
+    "s",        // TR_SEARCH_NAME
+    "i",        // TR_GET_STUDENT
+    "",         // TR_LIST_STUDENTS
+    "iss",      // TR_ADD_QUERY
+    "",         // TR_LIST_QUERIES
+    "s",        // TR_FILTER_STUDENTS
+    "s",        // TR_FILTER_QUERIES
+    "iific",    // TR_SEM_RESULT
+    "i",        // TR_RESOLVE_QUERY
+    "ll",       // TR_JOINED_QUERIES
+    "i",        // TR_FALLING_CGPA
+    "i"         // TR_GET_QUERY
+};
+
+bool replay_skipArgs(uint8_t op, const char*& p, const char* end) {
+    if (op == 0 || op >= sizeof TRACE_ARG_TYPES / sizeof TRACE_ARG_TYPES[0])
+        return false;
+    int i; long long l; float f; char c; string s; Student st;
+    for (const char* t = TRACE_ARG_TYPES[op]; *t; ++t) {
+        bool ok = (*t == 'i') ? value_decode(p, end, i)
+                : (*t == 'l') ? value_decode(p, end, l)
+                : (*t == 'f') ? value_decode(p, end, f)
+                : (*t == 'c') ? value_decode(p, end, c)
+                : (*t == 'S') ? schema_decode(p, end, st)
+                :               value_decode(p, end, s);
+        if (!ok) return false;
+    }
+    return true;
+}
+
+bool replay_loadTrace(const string& path, vector<ReplayOp>& ops, string& err) {
+    string data;
+    if (!read_file(path, data)) {
+        err = "cannot read " + path;
+        return false;
+    }
+    if (data.size() < 8 || std::memcmp(data.data(), TRACE_MAGIC, 7) != 0) {
+        err = path + " is not a trace file (and not mix:L/U/Q)";
+        return false;
+    }
+    if (data[7] != TRACE_MAGIC[7]) {
+        err = path + " is trace format version " + data[7] + "; this build replays version " +
+              TRACE_MAGIC[7] + " only (record the trace again)";
+        return false;
+    }
+    err = path + " is truncated or corrupt";
+
+    const char* p   = data.data() + 8;
+    const char* end = data.data() + data.size();
+    uint64_t atUs = 0;
+    while (p < end) {
+        uint64_t gapUs;
+        if (!get_varint(p, end, gapUs) || p >= end) return false;
+        ReplayOp r;
+        r.atUs = atUs += gapUs;
+        r.op   = (uint8_t)*p++;
+        if (!get_varint(p, end, r.durNs)) return false;
+
+        const char* args = p;
+        if (!replay_skipArgs(r.op, p, end)) return false;
+        r.args.assign(args, (size_t)(p - args));
+        ops.push_back(std::move(r));
+    }
+    return true;
+}
+
+// "mix:90/5/5" -> lookups / updates / new queries over a pre-loaded roster
+bool replay_synthetic(const string& spec, size_t count, int students, vector<ReplayOp>& ops) {
+    int look = 0, upd = 0, qry = 0;
+    if (std::sscanf(spec.c_str(), "mix:%d/%d/%d", &look, &upd, &qry) != 3 ||
+        look < 0 || upd < 0 || qry < 0 || look + upd + qry != 100 || students <= 0)
+        return false;
+
+    for (int r = 1; r <= students; ++r) {
+        Student s{};
+        s.roll  = r;
+        s.name  = "Student " + std::to_string(r);
+        s.dept  = "CSE";
+        s.sem   = 1 + r % 8;
+        s.cgpa  = 5.0f + (float)(r % 50) / 10.0f;
+        s.grade = (char)('A' + r % 5);
+        backend_addStudent(s);
+    }
+
+    uint64_t x = 88172645463325252ull;     // xorshift, so runs are repeatable
+    auto rnd = [&x]() { x ^= x << 13; x ^= x >> 7; x ^= x << 17; return x; };
+
+    ops.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        int pick = (int)(rnd() % 100);
+        int roll = 1 + (int)(rnd() % (uint64_t)students);
+        ReplayOp r;
+        if (pick < look) {
+            r.op = TR_GET_STUDENT;
+            trace_args(r.args, roll);
+        } else if (pick < look + upd) {
+            Student s{};
+            s.roll  = roll;
+            s.name  = "Student " + std::to_string(roll);
+            s.dept  = "CSE";
+            s.sem   = 1 + roll % 8;
+            s.cgpa  = 4.0f + (float)(rnd() % 60) / 10.0f;
+            s.grade = (char)('A' + rnd() % 5);
+            r.op = TR_UPDATE_STUDENT;
+            trace_args(r.args, s);
+        } else {
+            r.op = TR_ADD_QUERY;
+            trace_args(r.args, roll, "Student " + std::to_string(roll), string("load test query"));
         }
+        ops.push_back(std::move(r));
     }
-    return "Student not found.";
+    return true;
 }
 
-string backend_getAllStudents() {
-    ostringstream oss;
-    // header
-    oss << std::left
-        << setw(5)  << "ROLL"  << " "
-        << setw(18) << "NAME"
-        << setw(10) << "DEPT"
-        << setw(6)  << "SEM"
-        << setw(7)  << "CGPA"
-        << setw(7)  << "GRADE"
-        << "STATUS" << "\r\n";
-
-    oss << "---------------------------------------------------------------------\r\n";
-
-    if (gStudents.empty()) {
-        oss << "(No students added yet)\r\n";
-    } else {
-        for (const auto& s : gStudents) {
-            string status;
-            if (s.cgpa >= 8.0f)      status = "Excellent";
-            else if (s.cgpa >= 7.0f) status = "Very Good";
-            else if (s.cgpa >= 6.0f) status = "Good";
-            else if (s.cgpa >= 5.0f) status = "Average";
-            else                     status = "Needs Help";
+// p50 .. max of ns samples, printed in us
+void replay_printLatency(const char* what, vector<uint64_t>& ns) {
+    std::sort(ns.begin(), ns.end());
+    auto pct = [&ns](double q) -> double {
+        if (ns.empty()) return 0.0;
+        size_t i = std::min(ns.size() - 1, (size_t)(q * (double)ns.size()));
+        return (double)ns[i] / 1000.0;
+    };
+    std::printf("%s us: p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n",
+                what, pct(0.50), pct(0.90), pct(0.99), pct(0.999), pct(1.0));
+}
+
+void replay_report(const vector<ReplayOp>& ops, vector<uint64_t>& lat, double seconds,
+                   size_t errors, int threads, const string& pace) {
+    std::printf("ops %zu in %.3f s = %.0f ops/s  (threads %d, pace %s)\n",
+                lat.size(), seconds, seconds > 0 ? (double)lat.size() / seconds : 0.0,
+                threads, pace.c_str());
+    replay_printLatency("latency", lat);
+
+    // a trace also carries what production saw
+    if (!ops.empty() && ops.back().durNs) {
+        vector<uint64_t> recorded;
+        recorded.reserve(ops.size());
+        for (const auto& r : ops) recorded.push_back(r.durNs);
+        std::printf("recorded: %zu ops over %.3f s\n", ops.size(), (double)ops.back().atUs / 1e6);
+        replay_printLatency("recorded service", recorded);
+    }
+    if (errors)
+        std::printf("%zu calls had undecodable arguments\n", errors);
+}
 
-            oss << std::left
-                << setw(5)  << s.roll << " "
-                << setw(18) << s.name
-                << setw(10) << s.dept
-                << setw(6)  << s.sem
-                << setw(7)  << s.cgpa
-                << setw(7)  << s.grade
-                << status   << "\r\n";
+// rate > 0: fixed ops/s; speed > 0: recorded schedule / speed; else unpaced
+int replay_run(const vector<ReplayOp>& ops, double rate, double speed, int threads) {
+    if (threads < 1) threads = 1;
+    std::atomic<size_t> next(0), errors(0);
+    vector<vector<uint64_t>> lat((size_t)threads);
+    const bool paced = rate > 0 || speed > 0;
+    const uint64_t start = steady_ns();
+
+    auto worker = [&](int t) {
+        lat[(size_t)t].reserve(ops.size() / (size_t)threads + 1);
+        for (size_t i; (i = next++) < ops.size(); ) {
+            uint64_t begin = steady_ns();
+            if (paced) {
+                uint64_t due = start + (uint64_t)(speed > 0 ? (double)ops[i].atUs * 1e3 / speed
+                                                            : (double)i * 1e9 / rate);
+                // sleep in short slices until close, then spin: oversleeping
+                // (worse on the long idle gaps of a recorded trace) would
+                // otherwise show up as store latency
+                const uint64_t SPIN_NS = 2000000, SLICE_NS = 10000000;
+                for (uint64_t now = begin; due > now + SPIN_NS; now = steady_ns())
+                    std::this_thread::sleep_for(std::chrono::nanoseconds(
+                        std::min(due - now - SPIN_NS, SLICE_NS)));
+                while (steady_ns() < due) std::this_thread::yield();
+                begin = due;                      // charge queueing delay too
+            }
+            {
+                std::lock_guard<std::mutex> lock(gStoreMutex);
+                if (!replay_execute(ops[i])) ++errors;
+            }
+            lat[(size_t)t].push_back(steady_ns() - begin);
         }
+    };
+
+    vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) pool.emplace_back(worker, t);
+    for (auto& th : pool) th.join();
+    double seconds = (double)(steady_ns() - start) / 1e9;
+
+    vector<uint64_t> all;
+    all.reserve(ops.size());
+    for (auto& v : lat) all.insert(all.end(), v.begin(), v.end());
+    char pace[48] = "unlimited";
+    if (speed > 0)     std::snprintf(pace, sizeof pace, "recorded x%g", speed);
+    else if (rate > 0) std::snprintf(pace, sizeof pace, "%.0f ops/s", rate);
+    replay_report(ops, all, seconds, errors, threads, pace);
+    return 0;
+}
+
+int console_replay(int argc, char** argv) {
+    string source = argv[2];
+    double rate = 0, speed = 0;
+    int threads = 1, students = 10000;
+    size_t count = 100000;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if      (flag == "--rate")     rate     = std::atof(argv[i + 1]);
+        else if (flag == "--speed")    speed    = std::atof(argv[i + 1]);
+        else if (flag == "--threads")  threads  = std::atoi(argv[i + 1]);
+        else if (flag == "--ops")      count    = (size_t)std::atoll(argv[i + 1]);
+        else if (flag == "--students") students = std::atoi(argv[i + 1]);
+        else { std::cerr << "unknown option " << flag << std::endl; return 1; }
+    }
+
+    bool mix = source.compare(0, 4, "mix:") == 0;
+    if ((rate > 0 && speed > 0) || (mix && speed > 0)) {
+        std::cerr << "use either --rate or --speed; --speed needs a trace file" << std::endl;
+        return 1;
+    }
+
+    vector<ReplayOp> ops;
+    string err = "bad mix " + source + " (mix:L/U/Q summing to 100)";
+    bool ok = mix ? replay_synthetic(source, count, students, ops)
+                  : replay_loadTrace(source, ops, err);
+    if (!ok) {
+        std::cerr << err << std::endl;
+        return 1;
     }
-    return oss.str();
+    return replay_run(ops, rate, speed, threads);
 }
 
-int backend_addQuery(int roll,
-                     const string& name,
-                     const string& message) {
-    if (roll <= 0 || name.empty() || message.empty())
-        return -1;
+// ======================== CONSOLE MODE ========================
+// srms_gui --follower <dir>   read-only replica of the leader writing <dir>
+// srms_gui --leader <dir>     SRMS_NO_GUI builds: headless leader; the GUI
+//                             build opens the normal window as the leader
+// One command per line on stdin; "help" lists them.
+
+vector<string> console_split(const string& line) {
+    vector<string> out;
+    size_t i = 0;
+    while (i < line.size()) {
+        while (i < line.size() && std::isspace((unsigned char)line[i])) ++i;
+        if (i >= line.size()) break;
+        if (line[i] == '"') {
+            size_t j = line.find('"', i + 1);
+            if (j == string::npos) j = line.size();
+            out.push_back(line.substr(i + 1, j - i - 1));
+            i = j + 1;
+        } else {
+            size_t j = i;
+            while (j < line.size() && !std::isspace((unsigned char)line[j])) ++j;
+            out.push_back(line.substr(i, j - i));
+            i = j;
+        }
+    }
+    return out;
+}
 
-    Query q;
-    q.id      = gNextQueryId++;
-    q.roll    = roll;
-    q.name    = name;
-    q.message = message;
-    q.status  = "Pending";
+const int CONSOLE_TICK_MS = 1000;
+
+// Next line of stdin: 1 = got one, 0 = none within timeoutMs, -1 = end of
+// input. Reads fd 0 directly: lines sitting in a stdio buffer would be
+// invisible to poll(). Windows consoles block without a timeout.
+int console_readLine(string& line, int timeoutMs) {
+#ifdef _WIN32
+    (void)timeoutMs;
+    return std::getline(std::cin, line) ? 1 : -1;
+#else
+    static string buf;
+    static bool   eof = false;
+    for (;;) {
+        size_t nl = buf.find('\n');
+        if (nl != string::npos || (eof && !buf.empty())) {
+            if (nl == string::npos) nl = buf.size();
+            line.assign(buf, 0, nl);
+            buf.erase(0, nl + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            return 1;
+        }
+        if (eof) return -1;
+
+        pollfd pfd{0, POLLIN, 0};
+        int ready = poll(&pfd, 1, timeoutMs);
+        if (ready == 0) return 0;
+        if (ready < 0 && errno != EINTR) return -1;
+        if (ready < 0) continue;
+
+        char tmp[4096];
+        ssize_t n = read(0, tmp, sizeof tmp);
+        if (n > 0)                       buf.append(tmp, (size_t)n);
+        else if (n == 0 || errno != EINTR) eof = true;
+    }
+#endif
+}
 
-    gQueries.push_back(q);
-    return q.id;
+// leader housekeeping (heartbeats, SLA escalations, archiving), then print
+// whatever it raised
+void console_tick() {
+    backend_tick();
+    for (const auto& n : backend_takeNotifications())
+        std::cout << n << std::endl;
 }
 
-string backend_getAllQueries() {
-    ostringstream oss;
-    oss << std::left
-        << setw(4)  << "ID"
-        << setw(6)  << "ROLL"
-        << setw(15) << "NAME"
-        << setw(10) << "STATUS"
-        << "MESSAGE" << "\r\n";
-
-    oss << "---------------------------------------------------------------------\r\n";
-
-    if (gQueries.empty()) {
-        oss << "(No queries submitted yet)\r\n";
-    } else {
-        for (const auto& q : gQueries) {
-            oss << std::left
-                << setw(4)  << q.id
-                << setw(6)  << q.roll
-                << setw(15) << q.name
-                << setw(10) << q.status
-                << q.message << "\r\n";
+// Runs commands from stdin. Between commands the leader still ticks once a
+// second, and a follower keeps applying the log.
+int console_run(bool leader) {
+    string line;
+    for (;;) {
+        int got = console_readLine(line, CONSOLE_TICK_MS);
+        if (got < 0) break;
+        if (got == 0) {
+            if (leader) console_tick();
+            else        replication_poll();
+            continue;
         }
+        if (!leader) replication_poll();
+
+        vector<string> a = console_split(line);
+        if (a.empty()) continue;
+        const string& cmd = a[0];
+        string out;
+
+        if (cmd == "quit" || cmd == "exit") {
+            break;
+        } else if (cmd == "get" && a.size() == 2) {
+            out = backend_getStudentByRoll(std::atoi(a[1].c_str()));
+        } else if (cmd == "list") {
+            out = backend_getAllStudents();
+        } else if (cmd == "qget" && a.size() == 2) {
+            out = backend_getQueryById(std::atoi(a[1].c_str()));
+        } else if (cmd == "queries") {
+            out = backend_getAllQueries();
+        } else if (cmd == "filter" || cmd == "qfilter") {
+            string expr = line.substr(line.find(cmd) + cmd.size());
+            if (cmd == "filter") backend_filterStudents(expr, out);
+            else                 backend_filterQueries(expr, out);
+        } else if (cmd == "joined" && a.size() >= 2) {
+            size_t size = a.size() >= 3 ? (size_t)std::atoi(a[2].c_str()) : 50;
+            out = backend_getJoinedQueries((size_t)std::atoi(a[1].c_str()), size);
+        } else if (cmd == "falling" && a.size() == 2) {
+            out = backend_getFallingCgpa(std::atoi(a[1].c_str()));
+        } else if (cmd == "lag" && !leader) {
+            out = replication_status();
+        } else if (leader && (cmd == "add" || cmd == "update") &&
+                   a.size() == 1 + schema_inputCount<Student>()) {
+            Student s{};
+            schema_parse(vector<string>(a.begin() + 1, a.end()), s);
+            bool ok = (cmd == "add") ? backend_addStudent(s) : backend_updateStudent(s);
+            out = ok ? "ok" : "failed";
+        } else if (leader && cmd == "del" && a.size() == 2) {
+            out = backend_deleteStudent(std::atoi(a[1].c_str())) ? "ok" : "not found";
+        } else if (leader && cmd == "query" && a.size() == 4) {
+            int id = backend_addQuery(std::atoi(a[1].c_str()), a[2], a[3]);
+            out = id < 0 ? "failed" : "query " + std::to_string(id);
+        } else if (leader && cmd == "result" && a.size() == 6) {
+            bool ok = backend_addSemesterResult(std::atoi(a[1].c_str()), std::atoi(a[2].c_str()),
+                                                (float)std::atof(a[3].c_str()),
+                                                std::atoi(a[4].c_str()), a[5][0]);
+            out = ok ? "ok" : "failed";
+        } else if (leader && cmd == "resolve" && a.size() == 2) {
+            out = backend_resolveQuery(std::atoi(a[1].c_str())) ? "ok" : "not found";
+        } else if (leader && cmd == "archive") {
+            // optional arg: pretend this many days have passed (for testing the policy)
+            long long days = a.size() >= 2 ? std::atoll(a[1].c_str()) : 0;
+            size_t moved = backend_archiveCold(now_s() + days * 24 * 60 * 60);
+            out = "moved " + std::to_string(moved) + "\n" + backend_archiveStats();
+        } else if (leader && cmd == "checkpoint") {
+            out = replication_checkpoint() ? "ok" : "failed";
+        } else if (cmd == "help") {
+            out = "get <roll> | qget <id> | list | queries | joined <page> [size] | filter <expr> | qfilter <expr> | falling <n>";
+            out += leader ? "\nadd|update " + schema_inputUsage<Student>() + " | del <roll>"
+                            "\nquery <roll> <name> <msg> | result <roll> <sem> <sgpa> <credits> <grade>"
+                            "\nresolve <id> | archive [days ahead] | checkpoint | quit"
+                          : " | lag | quit";
+        } else {
+            out = "unknown command (try help)";
+        }
+
+        std::cout << out << std::endl;
+        if (leader) console_tick();
+    }
+    return 0;
+}
+
+int console_follower(const string& dir) {
+    gFollower.dir = dir;
+    replication_poll();
+    return console_run(false);
+}
+
+int console_leader(const string& dir) {
+    if (!replication_openLeader(dir)) {
+        std::cerr << "cannot write replication files in " << dir << std::endl;
+        return 1;
     }
-    return oss.str();
+    return console_run(true);
 }
 
+#ifndef SRMS_NO_GUI
+
 // ======================== GUI PART (WIN32) ========================
 
 LRESULT CALLBACK MainWndProc(HWND, UINT, WPARAM, LPARAM);
@@ -259,40 +3351,42 @@ string GetEditText(HWND h) {
 
 // ======================== FRONTEND ACTIONS ========================
 
-void GUI_AddStudent(HWND hwnd) {
-    string rollStr  = GetEditText(hAdminRoll);
-    string name     = GetEditText(hAdminName);
-    string dept     = GetEditText(hAdminDept);
-    string semStr   = GetEditText(hAdminSem);
-    string cgpaStr  = GetEditText(hAdminCgpa);
-    string gradeStr = GetEditText(hAdminGrade);
+// admin form boxes, one per Student input column, in schema order
+HWND* const ADMIN_FIELD_EDITS[] = {
+    &hAdminRoll, &hAdminName, &hAdminDept, &hAdminSem, &hAdminCgpa, &hAdminGrade
+};
+static_assert(sizeof ADMIN_FIELD_EDITS / sizeof ADMIN_FIELD_EDITS[0] == schema_inputCount<Student>(),
+              "one admin box per Student input column");
+
+// reads the admin form into s, where empty boxes leave their field as it
+// is; false if a box is empty and allowBlank is not set
+bool GUI_ReadStudentForm(Student& s, bool allowBlank = false) {
+    vector<string> cols;
+    for (HWND* h : ADMIN_FIELD_EDITS) {
+        cols.push_back(GetEditText(*h));
+        if (cols.back().empty() && !allowBlank) return false;
+    }
+    return schema_parse(cols, s);
+}
 
-    if (rollStr.empty() || name.empty() || dept.empty() ||
-        semStr.empty()  || cgpaStr.empty() || gradeStr.empty()) {
+void GUI_AddStudent(HWND hwnd) {
+    Student s{};
+    if (!GUI_ReadStudentForm(s)) {
         InfoBox(hwnd, "For adding a student, please fill ALL fields.");
         return;
     }
 
-    int   roll = std::atoi(rollStr.c_str());
-    int   sem  = std::atoi(semStr.c_str());
-    float cgpa = (float)std::atof(cgpaStr.c_str());
-    char  grade = gradeStr[0];
-
-    bool ok = backend_addStudent(roll, name, dept, sem, cgpa, grade);
+    bool ok = backend_addStudent(s);
     if (!ok) {
-        InfoBox(hwnd, "Invalid student data.", "Error");
+        InfoBox(hwnd, "Invalid student data, or a student with this roll already exists.", "Error");
         return;
     }
 
     InfoBox(hwnd, "Student added successfully.");
 
     // clear boxes
-    SetWindowTextA(hAdminRoll,  "");
-    SetWindowTextA(hAdminName,  "");
-    SetWindowTextA(hAdminDept,  "");
-    SetWindowTextA(hAdminSem,   "");
-    SetWindowTextA(hAdminCgpa,  "");
-    SetWindowTextA(hAdminGrade, "");
+    for (HWND* h : ADMIN_FIELD_EDITS)
+        SetWindowTextA(*h, "");
 
     // auto-refresh table
     string out = backend_getAllStudents();
@@ -301,35 +3395,28 @@ void GUI_AddStudent(HWND hwnd) {
 
 // update student details (used when admin wants to correct record)
 void GUI_UpdateStudent(HWND hwnd) {
-    string rollStr  = GetEditText(hAdminRoll);
-    string name     = GetEditText(hAdminName);
-    string dept     = GetEditText(hAdminDept);
-    string semStr   = GetEditText(hAdminSem);
-    string cgpaStr  = GetEditText(hAdminCgpa);
-    string gradeStr = GetEditText(hAdminGrade);
-
-    if (rollStr.empty()) {
+    if (GetEditText(hAdminRoll).empty()) {
         InfoBox(hwnd, "Please enter Roll number to update student.");
         return;
     }
-    if (name.empty() || dept.empty() || semStr.empty() ||
-        cgpaStr.empty() || gradeStr.empty()) {
-        InfoBox(hwnd, "For updating, fill all fields with the NEW details.");
+    // boxes left empty keep the stored value
+    Student s{};
+    if (!store_getStudent(std::atoi(GetEditText(hAdminRoll).c_str()), s)) {
+        InfoBox(hwnd, "Student with this roll not found.", "Update Failed");
         return;
     }
+    GUI_ReadStudentForm(s, true);
 
-    int   roll = std::atoi(rollStr.c_str());
-    int   sem  = std::atoi(semStr.c_str());
-    float cgpa = (float)std::atof(cgpaStr.c_str());
-    char  grade = gradeStr[0];
-
-    bool ok = backend_updateStudent(roll, name, dept, sem, cgpa, grade);
+    bool ok = backend_updateStudent(s);
     if (!ok) {
-        InfoBox(hwnd, "Student with this roll not found.", "Update Failed");
+        InfoBox(hwnd, "Invalid student data (CGPA must be 0-10).", "Update Failed");
         return;
     }
 
-    InfoBox(hwnd, "Student details updated successfully.");
+    InfoBox(hwnd, backend_getHistory(s.roll).empty()
+                      ? "Student details updated successfully."
+                      : "Student details updated successfully.\r\n"
+                        "Sem, CGPA and grade follow the semester history.");
 
     // refresh table so changes are visible
     string out = backend_getAllStudents();
@@ -359,6 +3446,39 @@ void GUI_DeleteStudent(HWND hwnd) {
     SetWindowTextA(hAdminOutput, out.c_str());
 }
 
+// record a finished semester: Roll + Semester + CGPA box (read as that
+// semester's SGPA) + Grade. The form has no credits box, so every semester
+// counts the same.
+const int GUI_SEM_CREDITS = 20;
+
+void GUI_AddSemResult(HWND hwnd) {
+    string rollStr  = GetEditText(hAdminRoll);
+    string semStr   = GetEditText(hAdminSem);
+    string sgpaStr  = GetEditText(hAdminCgpa);
+    string gradeStr = GetEditText(hAdminGrade);
+
+    if (rollStr.empty() || semStr.empty() || sgpaStr.empty() || gradeStr.empty()) {
+        InfoBox(hwnd, "For a semester result, fill Roll, Semester, CGPA (this semester's SGPA) and Grade.");
+        return;
+    }
+
+    int   roll = std::atoi(rollStr.c_str());
+    int   sem  = std::atoi(semStr.c_str());
+    float sgpa = (float)std::atof(sgpaStr.c_str());
+
+    if (!backend_addSemesterResult(roll, sem, sgpa, GUI_SEM_CREDITS, gradeStr[0])) {
+        InfoBox(hwnd, "Could not record result (unknown roll, invalid SGPA, "
+                      "or semester not after the last one).", "Error");
+        return;
+    }
+
+    string info = "Result recorded.\r\n\r\n" + backend_getStudentByRoll(roll);
+    InfoBox(hwnd, info.c_str(), "Semester Result");
+
+    string out = backend_getAllStudents();
+    SetWindowTextA(hAdminOutput, out.c_str());
+}
+
 void GUI_ViewStudents() {
     string out = backend_getAllStudents();
     SetWindowTextA(hAdminOutput, out.c_str());
@@ -388,6 +3508,18 @@ void GUI_SearchName(HWND hwnd) {
     GUI_ViewStudents();
 }
 
+// filter expression typed into the search box, e.g. dept == "CSE" && cgpa < 6
+void GUI_FilterStudents(HWND hwnd) {
+    string expr = GetEditText(hSearchNameEdit);
+
+    string out;
+    if (!backend_filterStudents(expr, out)) {
+        InfoBox(hwnd, out.c_str(), "Filter Error");
+        return;
+    }
+    SetWindowTextA(hAdminOutput, out.c_str());
+}
+
 void GUI_AddQuery(HWND hwnd) {
     string rollStr = GetEditText(hStudRoll);
     string name    = GetEditText(hStudName);
@@ -418,6 +3550,36 @@ void GUI_ViewQueries() {
     SetWindowTextA(hStudOutput, out.c_str());
 }
 
+// joined view, one page per click (wraps around after the last page)
+const size_t GUI_JOIN_PAGE_SIZE = 200;
+
+void GUI_ViewJoinedQueries() {
+    static size_t page = 0;
+    size_t pages = (gQueries.size() + GUI_JOIN_PAGE_SIZE - 1) / GUI_JOIN_PAGE_SIZE;
+    if (page >= pages) page = 0;
+
+    string out = backend_getJoinedQueries(page++, GUI_JOIN_PAGE_SIZE);
+    SetWindowTextA(hStudOutput, out.c_str());
+}
+
+// timer tick: run backend housekeeping, then surface any SLA escalations
+// and replication errors
+void GUI_Tick(HWND hwnd) {
+    static bool showing = false;   // the message box pumps WM_TIMER too
+    backend_tick();
+    if (showing) return;
+
+    vector<string> notes = backend_takeNotifications();
+    if (notes.empty()) return;
+
+    string msg;
+    for (const auto& n : notes) msg += n + "\r\n";
+    GUI_ViewQueries();
+    showing = true;
+    InfoBox(hwnd, msg.c_str(), "SRMS Notifications");
+    showing = false;
+}
+
 // IDs
 #define ID_BTN_ADD_STU      1001
 #define ID_BTN_VIEW_STU     1002
@@ -426,12 +3588,17 @@ void GUI_ViewQueries() {
 #define ID_BTN_SEARCH_NAME  1005
 #define ID_BTN_UPDATE_STU   1006
 #define ID_BTN_DEL_STU      1007
+#define ID_BTN_FILTER       1008
+#define ID_BTN_SEM_RESULT   1009
+#define ID_BTN_JOINED_Q     1010
 
 #define ID_LOGIN_USER_EDIT  2001
 #define ID_LOGIN_PASS_EDIT  2002
 #define ID_LOGIN_OK         2003
 #define ID_LOGIN_CANCEL     2004
 
+#define ID_TIMER_TICK       3001   // 1s housekeeping (backend_tick)
+
 // ======================== WinMain (GUI entry) ========================
 
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int nCmdShow) {
@@ -594,25 +3761,29 @@ LRESULT CALLBACK MainWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
         hAdminGrade = CreateWindowA("EDIT", "", WS_CHILD | WS_VISIBLE | WS_BORDER | ES_AUTOHSCROLL,
                                     xE + 160, y, 60, h, hwnd, NULL, NULL, NULL);
 
-        // Admin buttons: Add, Update, Delete, View All
+        // Admin buttons: Add, Update, Delete, View All, Result
         CreateWindowA("BUTTON", "Add",
                       WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
-                      30, 270, 80, 28, hwnd, (HMENU)ID_BTN_ADD_STU, NULL, NULL);
+                      30, 270, 70, 28, hwnd, (HMENU)ID_BTN_ADD_STU, NULL, NULL);
 
         CreateWindowA("BUTTON", "Update",
                       WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
-                      120, 270, 80, 28, hwnd, (HMENU)ID_BTN_UPDATE_STU, NULL, NULL);
+                      105, 270, 70, 28, hwnd, (HMENU)ID_BTN_UPDATE_STU, NULL, NULL);
 
         CreateWindowA("BUTTON", "Delete",
                       WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
-                      210, 270, 80, 28, hwnd, (HMENU)ID_BTN_DEL_STU, NULL, NULL);
+                      180, 270, 70, 28, hwnd, (HMENU)ID_BTN_DEL_STU, NULL, NULL);
 
         CreateWindowA("BUTTON", "View All",
                       WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
-                      300, 270, 80, 28, hwnd, (HMENU)ID_BTN_VIEW_STU, NULL, NULL);
+                      255, 270, 70, 28, hwnd, (HMENU)ID_BTN_VIEW_STU, NULL, NULL);
+
+        CreateWindowA("BUTTON", "Result",
+                      WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
+                      330, 270, 70, 28, hwnd, (HMENU)ID_BTN_SEM_RESULT, NULL, NULL);
 
         // Search-by-name panel
-        CreateWindowA("BUTTON", "Search / Auto-add by Name",
+        CreateWindowA("BUTTON", "Search / Auto-add by Name, or Filter",
                       WS_CHILD | WS_VISIBLE | BS_GROUPBOX,
                       20, 340, 400, 90, hwnd, NULL, NULL, NULL);
 
@@ -625,6 +3796,10 @@ LRESULT CALLBACK MainWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
                       WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
                       140, 392, 120, 26, hwnd, (HMENU)ID_BTN_SEARCH_NAME, NULL, NULL);
 
+        CreateWindowA("BUTTON", "Filter",
+                      WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
+                      270, 392, 100, 26, hwnd, (HMENU)ID_BTN_FILTER, NULL, NULL);
+
         // Student - Queries (final layout: both buttons visible)
         CreateWindowA("BUTTON", "Student - Queries",
                       WS_CHILD | WS_VISIBLE | BS_GROUPBOX,
@@ -658,11 +3833,15 @@ LRESULT CALLBACK MainWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 
         CreateWindowA("BUTTON", "Submit Query",
                       WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
-                      40, btnY, 120, 26, hwnd, (HMENU)ID_BTN_ADD_Q, NULL, NULL);
+                      35, btnY, 105, 26, hwnd, (HMENU)ID_BTN_ADD_Q, NULL, NULL);
 
         CreateWindowA("BUTTON", "View All Queries",
                       WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
-                      190, btnY, 160, 26, hwnd, (HMENU)ID_BTN_VIEW_Q, NULL, NULL);
+                      148, btnY, 120, 26, hwnd, (HMENU)ID_BTN_VIEW_Q, NULL, NULL);
+
+        CreateWindowA("BUTTON", "With Student Info",
+                      WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
+                      276, btnY, 130, 26, hwnd, (HMENU)ID_BTN_JOINED_Q, NULL, NULL);
 
         // Right-side titles (new)
         hAdminOutLabel = CreateWindowA("STATIC", "Student Records",
@@ -684,9 +3863,14 @@ LRESULT CALLBACK MainWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
                       ES_MULTILINE | ES_AUTOVSCROLL | WS_VSCROLL | ES_READONLY,
                       440, 360, 430, 250, hwnd, NULL, NULL, NULL);
 
+        SetTimer(hwnd, ID_TIMER_TICK, 1000, NULL);
         return 0;
     }
 
+    case WM_TIMER:
+        if (wParam == ID_TIMER_TICK) GUI_Tick(hwnd);
+        return 0;
+
     case WM_COMMAND: {
         switch (LOWORD(wParam)) {
         case ID_BTN_ADD_STU:     GUI_AddStudent(hwnd);    break;
@@ -694,8 +3878,11 @@ LRESULT CALLBACK MainWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
         case ID_BTN_DEL_STU:     GUI_DeleteStudent(hwnd); break;
         case ID_BTN_VIEW_STU:    GUI_ViewStudents();      break;
         case ID_BTN_SEARCH_NAME: GUI_SearchName(hwnd);    break;
+        case ID_BTN_FILTER:      GUI_FilterStudents(hwnd); break;
+        case ID_BTN_SEM_RESULT:  GUI_AddSemResult(hwnd);  break;
         case ID_BTN_ADD_Q:       GUI_AddQuery(hwnd);      break;
         case ID_BTN_VIEW_Q:      GUI_ViewQueries();   break;
+        case ID_BTN_JOINED_Q:    GUI_ViewJoinedQueries(); break;
         }
         return 0;
     }
@@ -769,6 +3956,7 @@ LRESULT CALLBACK MainWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
     }
 
     case WM_DESTROY:
+        KillTimer(hwnd, ID_TIMER_TICK);
         if (gHeaderFont)    { DeleteObject(gHeaderFont);    gHeaderFont    = NULL; }
         if (gMainBgBrush)   { DeleteObject(gMainBgBrush);   gMainBgBrush   = NULL; }
         if (gOutputBgBrush) { DeleteObject(gOutputBgBrush); gOutputBgBrush = NULL; }
@@ -853,9 +4041,61 @@ LRESULT CALLBACK LoginWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
     return DefWindowProcA(hwnd, msg, wParam, lParam);
 }
 
+#endif  // SRMS_NO_GUI
+
 // ======================== Entry point (normal main) ========================
 
-int main() {
+int main(int argc, char** argv) {
+    string mode = (argc >= 3) ? argv[1] : "";
+    if (mode == "--follower") {
+        // the leader's archive file, as seen from here
+        string archiveFile = string(argv[2]) + "/srms.archive";
+        if (argc >= 5 && string(argv[3]) == "--archive") archiveFile = argv[4];
+        archive_setPath(archiveFile);
+        return console_follower(argv[2]);
+    }
+    if (mode == "--replay")
+        return console_replay(argc, argv);
+
+    // these combine: --leader <dir> --trace <file> --archive <file>
+    string leaderDir, traceFile, archiveFile;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--leader")       leaderDir = argv[i + 1];
+        else if (flag == "--trace")   traceFile = argv[i + 1];
+        else if (flag == "--archive") archiveFile = argv[i + 1];
+    }
+    // followers read the archive too, so a leader keeps it next to its log
+    if (archiveFile.empty() && !leaderDir.empty())
+        archiveFile = leaderDir + "/srms.archive";
+    if (!archiveFile.empty())
+        archive_setPath(archiveFile);
+
+#ifdef SRMS_NO_GUI
+    if (leaderDir.empty()) {
+        std::cerr << "usage: " << argv[0] << " --leader <dir> [--trace <file>] [--archive <file>] | --follower <dir> [--archive <file>]"
+                     " | --replay <trace|mix:L/U/Q> [--rate N | --speed F] [--threads N] [--ops N] [--students N]"
+                  << std::endl;
+        return 1;
+    }
+    if (!traceFile.empty() && !trace_start(traceFile)) {
+        std::cerr << "cannot write trace " << traceFile << std::endl;
+        return 1;
+    }
+    int rc = console_leader(leaderDir);
+    trace_stop();
+    return rc;
+#else
+    if (!leaderDir.empty() && !replication_openLeader(leaderDir)) {
+        MessageBoxA(NULL, "Cannot write replication files in the given directory.",
+                    "SRMS", MB_OK | MB_ICONERROR);
+        return 1;
+    }
+    if (!traceFile.empty() && !trace_start(traceFile)) {
+        MessageBoxA(NULL, "Cannot write the trace file.", "SRMS", MB_OK | MB_ICONERROR);
+        return 1;
+    }
+
     // hide console window, only GUI visible
     HWND hConsole = GetConsoleWindow();
     if (hConsole) {
@@ -863,5 +4103,8 @@ int main() {
     }
 
     HINSTANCE hInst = GetModuleHandleA(NULL);
-    return WinMain(hInst, NULL, GetCommandLineA(), SW_SHOWNORMAL);
+    int rc = WinMain(hInst, NULL, GetCommandLineA(), SW_SHOWNORMAL);
+    trace_stop();
+    return rc;
+#endif
 }